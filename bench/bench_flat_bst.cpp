@@ -0,0 +1,76 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "flat_bst.hpp"
+#include "level_order.hpp"
+
+using namespace Container;
+
+namespace
+{
+
+// Complete tree of the odd values below 2 * size
+FlatBst<std::uint32_t> make_tree(std::uint32_t size)
+{
+  FlatBst<std::uint32_t> tree;
+  Testing::insert_level_order(tree, size, [](size_t i) { return std::uint32_t(i * 2 + 1); });
+
+  return tree;
+}
+
+template <class Func>
+void run(const char* name, size_t lookups, Func f)
+{
+  const auto start = std::chrono::steady_clock::now();
+  const auto checksum = f();
+  const auto stop = std::chrono::steady_clock::now();
+
+  const auto ms = std::chrono::duration<double, std::milli>(stop - start).count();
+
+  std::cout << name << "\t" << ms << " ms"
+            << "\t" << lookups / ms / 1000 << " M lookups/s"
+            << "\tchecksum " << checksum << "\n";
+}
+
+} // namespace
+
+
+int main()
+{
+  constexpr std::uint32_t size = (1 << 23) - 1;
+  constexpr size_t lookups = 1 << 22;
+
+  const auto tree = make_tree(size);
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<std::uint32_t> key(0, 2 * size);
+
+  std::vector<std::uint32_t> keys(lookups);
+  for (auto& k : keys)
+    k = key(gen);
+
+  run("contains        ", lookups, [&] {
+    size_t found = 0;
+    for (const auto k : keys)
+      found += tree.contains(k);
+    return found;
+  });
+
+  for (const size_t group : {1, 2, 4, 8, 16, 32, 64, 128}) {
+    std::vector<char> results(lookups);
+
+    const std::string name = "find_many group " + std::to_string(group);
+    run(name.c_str(), lookups, [&] {
+      tree.find_many(keys.begin(), keys.end(), results.begin(), group);
+
+      size_t found = 0;
+      for (const auto result : results)
+        found += result;
+      return found;
+    });
+  }
+}
@@ -0,0 +1,189 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "dary_heap.hpp"
+#include "indexed_heap.hpp"
+#include "pairing_heap.hpp"
+
+using namespace Container;
+
+namespace
+{
+
+constexpr auto infinity = std::numeric_limits<std::uint64_t>::max();
+
+struct Edge
+{
+  std::uint32_t to;
+  std::uint32_t coast;
+};
+
+// Random sparse digraph in adjacency arrays
+struct Workload
+{
+  std::vector<std::uint32_t> offsets;
+  std::vector<Edge> edges;
+};
+
+Workload make_workload(std::uint32_t nodes, std::uint32_t degree)
+{
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<std::uint32_t> node(0, nodes - 1);
+  std::uniform_int_distribution<std::uint32_t> coast(1, 1000);
+
+  Workload w;
+  w.offsets.push_back(0);
+
+  for (std::uint32_t i = 0; i < nodes; ++i) {
+    for (std::uint32_t j = 0; j < degree; ++j)
+      w.edges.push_back({node(gen), coast(gen)});
+    w.offsets.push_back(w.edges.size());
+  }
+
+  return w;
+}
+
+using Distance = std::pair<std::uint64_t, std::uint32_t>;
+
+// Lazy deletion: stale entries are skipped when popped
+template <class Heap>
+std::uint64_t dijkstra_lazy(const Workload& w, Heap& heap)
+{
+  std::vector<std::uint64_t> dist(w.offsets.size() - 1, infinity);
+
+  dist[0] = 0;
+  heap.push({0, 0});
+
+  while (!heap.empty()) {
+    const auto [d, u] = heap.top();
+    heap.pop();
+
+    if (d != dist[u])
+      continue;
+
+    for (auto e = w.offsets[u]; e < w.offsets[u + 1]; ++e) {
+      const auto& edge = w.edges[e];
+      if (d + edge.coast < dist[edge.to]) {
+        dist[edge.to] = d + edge.coast;
+        heap.push({dist[edge.to], edge.to});
+      }
+    }
+  }
+
+  std::uint64_t sum = 0;
+  for (const auto d : dist)
+    sum += d == infinity ? 0 : d;
+  return sum;
+}
+
+std::uint64_t dijkstra_indexed(const Workload& w)
+{
+  std::vector<std::uint64_t> dist(w.offsets.size() - 1, infinity);
+  IndexedHeap<std::uint64_t> heap(dist.size());
+
+  dist[0] = 0;
+  heap.push(0, 0);
+
+  while (!heap.empty()) {
+    const auto u = heap.top();
+    const auto d = heap.top_value();
+    heap.pop();
+
+    for (auto e = w.offsets[u]; e < w.offsets[u + 1]; ++e) {
+      const auto& edge = w.edges[e];
+      if (d + edge.coast < dist[edge.to]) {
+        dist[edge.to] = d + edge.coast;
+        heap.push_or_decrease(edge.to, dist[edge.to]);
+      }
+    }
+  }
+
+  std::uint64_t sum = 0;
+  for (const auto d : dist)
+    sum += d == infinity ? 0 : d;
+  return sum;
+}
+
+std::uint64_t dijkstra_pairing(const Workload& w)
+{
+  using Heap = PairingHeap<Distance>;
+
+  std::vector<std::uint64_t> dist(w.offsets.size() - 1, infinity);
+  std::vector<size_t> handle(dist.size(), Heap::npos);
+  Heap heap;
+
+  dist[0] = 0;
+  handle[0] = heap.push({0, 0});
+
+  while (!heap.empty()) {
+    const auto [d, u] = heap.top();
+    heap.pop();
+    handle[u] = Heap::npos;
+
+    for (auto e = w.offsets[u]; e < w.offsets[u + 1]; ++e) {
+      const auto& edge = w.edges[e];
+      const auto nd = d + edge.coast;
+
+      if (nd < dist[edge.to]) {
+        if (handle[edge.to] == Heap::npos)
+          handle[edge.to] = heap.push({nd, edge.to});
+        else
+          heap.decrease_key(handle[edge.to], {nd, edge.to});
+        dist[edge.to] = nd;
+      }
+    }
+  }
+
+  std::uint64_t sum = 0;
+  for (const auto d : dist)
+    sum += d == infinity ? 0 : d;
+  return sum;
+}
+
+template <class Func>
+void run(const char* name, Func f)
+{
+  const auto start = std::chrono::steady_clock::now();
+  const auto checksum = f();
+  const auto stop = std::chrono::steady_clock::now();
+
+  std::cout << name << "\t"
+            << std::chrono::duration<double, std::milli>(stop - start).count() << " ms"
+            << "\tchecksum " << checksum << "\n";
+}
+
+} // namespace
+
+
+int main()
+{
+  const auto w = make_workload(1 << 20, 8);
+
+  run("std::priority_queue", [&] {
+    std::priority_queue<Distance, std::vector<Distance>, std::greater<Distance>> heap;
+    return dijkstra_lazy(w, heap);
+  });
+
+  run("DaryHeap<2>        ", [&] {
+    DaryHeap<Distance, 2> heap;
+    return dijkstra_lazy(w, heap);
+  });
+
+  run("DaryHeap<4>        ", [&] {
+    DaryHeap<Distance, 4> heap;
+    return dijkstra_lazy(w, heap);
+  });
+
+  run("DaryHeap<8>        ", [&] {
+    DaryHeap<Distance, 8> heap;
+    return dijkstra_lazy(w, heap);
+  });
+
+  run("IndexedHeap<4>     ", [&] { return dijkstra_indexed(w); });
+  run("PairingHeap        ", [&] { return dijkstra_pairing(w); });
+}
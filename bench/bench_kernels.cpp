@@ -0,0 +1,215 @@
+#include <cstdint>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "clist.hpp"
+#include "flat_bst.hpp"
+#include "flat_btree.hpp"
+#include "graph.hpp"
+#include "level_order.hpp"
+#include "quick_sort.hpp"
+#include "range_offset.hpp"
+#include "string_sort.hpp"
+
+#include "perf_counters.hpp"
+
+using namespace Container;
+
+namespace
+{
+
+// results go here so that no kernel is optimized away
+std::uint64_t checksum = 0;
+
+template <class Func>
+void run(const std::string& name, size_t elements, Func f)
+{
+  Bench::print_report(std::cout, name, Bench::measure(f), elements);
+}
+
+std::vector<std::uint32_t> random_values(size_t size, std::uint32_t max, unsigned seed)
+{
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<std::uint32_t> value(0, max);
+
+  std::vector<std::uint32_t> values(size);
+  for (auto& v : values)
+    v = value(gen);
+
+  return values;
+}
+
+// Both loops compile to the same inner loop, the offset one only clamps
+// begin first. Kept out of line so that the assembly can be compared,
+// e.g. with objdump -d.
+[[gnu::noinline]] std::uint64_t sum_raw(const std::uint32_t* first, const std::uint32_t* last)
+{
+  std::uint64_t sum = 0;
+  for (auto it = first; it != last; ++it)
+    sum += *it;
+
+  return sum;
+}
+
+[[gnu::noinline]] std::uint64_t sum_offset(const std::vector<std::uint32_t>& values, size_t skip)
+{
+  std::uint64_t sum = 0;
+  for (const auto v : values | Utility::offset(skip))
+    sum += v;
+
+  return sum;
+}
+
+void offset_kernels()
+{
+  constexpr size_t size = 1 << 22;
+  constexpr size_t skip = 3;
+
+  const auto values = random_values(size, UINT32_MAX, 5);
+
+  run("raw pointer loop", size - skip, [&] {
+    checksum += sum_raw(values.data() + skip, values.data() + size);
+  });
+
+  run("| offset(n) loop", size - skip, [&] {
+    checksum += sum_offset(values, skip);
+  });
+}
+
+void sort_kernels()
+{
+  constexpr size_t size = 1 << 20;
+
+  const auto values = random_values(size, UINT32_MAX, 1);
+
+  std::queue<std::uint32_t> q;
+  for (const auto v : values)
+    q.push(v);
+
+  run("quick_sort", size, [&] {
+    Sort::quick_sort(q);
+    checksum += q.front();
+  });
+
+  std::vector<std::string> urls;
+  urls.reserve(size / 2);
+  for (size_t i = 0; i < size / 2; ++i)
+    urls.push_back("https://example.com/item/" + std::to_string(values[i]));
+
+  run("string_sort", urls.size(), [&] {
+    Sort::string_sort(urls.begin(), urls.end());
+    checksum += urls.front().size();
+  });
+}
+
+void tree_kernels()
+{
+  constexpr std::uint32_t size = (1 << 22) - 1;
+  constexpr size_t lookups = 1 << 21;
+
+  // complete tree of the odd values, inserted in level order
+  FlatBst<std::uint32_t> bst;
+  Testing::insert_level_order(bst, size, [](size_t i) { return std::uint32_t(i * 2 + 1); });
+
+  std::vector<std::uint32_t> sorted;
+  for (std::uint32_t i = 0; i < size; ++i)
+    sorted.push_back(i * 2 + 1);
+
+  FlatBtree<std::uint32_t> btree;
+  btree.assign_sorted(sorted.begin(), sorted.end());
+
+  const auto keys = random_values(lookups, 2 * size, 2);
+
+  run("FlatBst contains", lookups, [&] {
+    for (const auto key : keys)
+      checksum += bst.contains(key);
+  });
+
+  run("FlatBst find_many", lookups, [&] {
+    std::vector<char> found(lookups);
+    bst.find_many(keys.begin(), keys.end(), found.begin());
+    for (const auto f : found)
+      checksum += f;
+  });
+
+  run("FlatBtree contains", lookups, [&] {
+    for (const auto key : keys)
+      checksum += btree.contains(key);
+  });
+}
+
+void list_kernels()
+{
+  constexpr size_t size = 1 << 20;
+
+  CList<std::uint32_t> list;
+  for (const auto v : random_values(size, UINT32_MAX, 3))
+    list.push_back(v);
+
+  run("CList walk (in order)", size, [&] {
+    for (auto it = list.begin(); it != list.end(); ++it)
+      checksum += *it;
+  });
+
+  run("CList sort", size, [&] {
+    list.sort();
+    checksum += list.front();
+  });
+
+  // sorting relinks the nodes, the walk now jumps around the heap
+  run("CList walk (relinked)", size, [&] {
+    for (auto it = list.begin(); it != list.end(); ++it)
+      checksum += *it;
+  });
+}
+
+void graph_kernels()
+{
+  constexpr std::uint32_t nodes = 1 << 18;
+  constexpr std::uint32_t degree = 8;
+
+  GraphCsr csr;
+  const auto targets = random_values(size_t(nodes) * degree, nodes - 1, 4);
+
+  for (std::uint32_t u = 0; u < nodes; ++u) {
+    csr.labels.push_back(std::to_string(u));
+
+    for (std::uint32_t j = 0; j < degree; ++j) {
+      csr.targets.push_back(targets[size_t(u) * degree + j]);
+      csr.weights.push_back(1);
+    }
+
+    csr.offsets.push_back(csr.targets.size());
+  }
+
+  const auto graph = Graph::from_csr(csr);
+
+  run("Graph bfs", nodes, [&] {
+    graph.bfs_iterate(0, [](const auto& node) {
+      checksum += node->adjacent.size();
+      return false;
+    });
+  });
+}
+
+} // namespace
+
+
+int main()
+{
+  if (!Bench::PerfCounters().available())
+    std::cout << "hardware counters unavailable, wall time only\n";
+
+  Bench::print_header(std::cout);
+
+  offset_kernels();
+  sort_kernels();
+  tree_kernels();
+  list_kernels();
+  graph_kernels();
+
+  std::cout << "checksum " << checksum << "\n";
+}
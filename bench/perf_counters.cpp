@@ -0,0 +1,174 @@
+#include "perf_counters.hpp"
+
+#include <iomanip>
+
+#if defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Bench {
+
+namespace {
+
+#if defined(__linux__)
+struct EventConfig
+{
+  std::uint32_t type;
+  std::uint64_t config;
+};
+
+// in the order of PerfEvent
+constexpr EventConfig configs[perf_event_count] = {
+  {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+  {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+  {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+  {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+  {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB
+                       | PERF_COUNT_HW_CACHE_OP_READ << 8
+                       | PERF_COUNT_HW_CACHE_RESULT_MISS << 16},
+};
+
+int open_event(const EventConfig& event)
+{
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+
+  attr.size = sizeof(attr);
+  attr.type = event.type;
+  attr.config = event.config;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+std::optional<std::uint64_t> read_event(int fd)
+{
+  // value, time enabled, time running
+  std::uint64_t values[3] = {};
+
+  if (read(fd, values, sizeof(values)) != static_cast<ssize_t>(sizeof(values)) || values[2] == 0)
+    return std::nullopt;
+
+  if (values[2] == values[1])
+    return values[0];
+
+  return static_cast<std::uint64_t>(static_cast<double>(values[0]) * values[1] / values[2]);
+}
+#endif
+
+void print_ratio(std::ostream& os, std::optional<std::uint64_t> count, double per, int width)
+{
+  if (count && per > 0)
+    os << std::setw(width) << static_cast<double>(*count) / per;
+  else
+    os << std::setw(width) << "-";
+}
+
+} // namespace
+
+
+PerfCounters::PerfCounters()
+{
+  fds_.fill(-1);
+
+#if defined(__linux__)
+  for (size_t i = 0; i < perf_event_count; ++i)
+    fds_[i] = open_event(configs[i]);
+#endif
+}
+
+PerfCounters::~PerfCounters()
+{
+#if defined(__linux__)
+  for (const auto fd : fds_)
+    if (fd >= 0)
+      close(fd);
+#endif
+}
+
+bool PerfCounters::available() const
+{
+  for (const auto fd : fds_)
+    if (fd >= 0)
+      return true;
+
+  return false;
+}
+
+void PerfCounters::start()
+{
+#if defined(__linux__)
+  for (const auto fd : fds_) {
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#endif
+
+  start_ = std::chrono::steady_clock::now();
+}
+
+PerfSample PerfCounters::stop()
+{
+  const auto stop = std::chrono::steady_clock::now();
+
+  PerfSample sample;
+  sample.seconds = std::chrono::duration<double>(stop - start_).count();
+
+#if defined(__linux__)
+  for (const auto fd : fds_)
+    if (fd >= 0)
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+  for (size_t i = 0; i < perf_event_count; ++i)
+    if (fds_[i] >= 0)
+      sample.events[i] = read_event(fds_[i]);
+#endif
+
+  return sample;
+}
+
+
+void print_header(std::ostream& os)
+{
+  os << std::left << std::setw(24) << "kernel" << std::right
+     << std::setw(10) << "ms"
+     << std::setw(8) << "IPC"
+     << std::setw(12) << "cycles/el"
+     << std::setw(12) << "cache/el"
+     << std::setw(12) << "branch/el"
+     << std::setw(12) << "tlb/el" << "\n";
+}
+
+void print_report(std::ostream& os, const std::string& name, const PerfSample& sample, size_t elements)
+{
+  const auto flags = os.flags();
+  const auto precision = os.precision();
+  const auto per = static_cast<double>(elements);
+
+  os << std::left << std::setw(24) << name << std::right << std::fixed
+     << std::setprecision(1) << std::setw(10) << sample.seconds * 1000
+     << std::setprecision(2);
+
+  const auto cycles = sample[PerfEvent::Cycles];
+  print_ratio(os, sample[PerfEvent::Instructions], cycles ? static_cast<double>(*cycles) : 0, 8);
+
+  print_ratio(os, cycles, per, 12);
+  print_ratio(os, sample[PerfEvent::CacheMisses], per, 12);
+  print_ratio(os, sample[PerfEvent::BranchMisses], per, 12);
+  print_ratio(os, sample[PerfEvent::TlbMisses], per, 12);
+
+  os << "\n";
+  os.flags(flags);
+  os.precision(precision);
+}
+
+} // namespace Bench
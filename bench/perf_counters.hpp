@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef> // size_t
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+
+namespace Bench {
+
+enum class PerfEvent { Cycles, Instructions, CacheMisses, BranchMisses, TlbMisses };
+
+constexpr size_t perf_event_count = 5;
+
+// What one region cost; an event is empty when it could not be counted
+struct PerfSample
+{
+  double seconds = 0;
+  std::array<std::optional<std::uint64_t>, perf_event_count> events;
+
+  std::optional<std::uint64_t> operator[] (PerfEvent event) const
+  {
+    return events[static_cast<size_t>(event)];
+  }
+};
+
+/*
+  Hardware event counters of the calling thread, user space only, read
+  through Linux perf_event_open. Every event is opened on its own: what
+  the kernel or the machine refuses (no PMU in a VM, perf_event_paranoid,
+  another OS) is left out and the rest is still counted. Wall time is
+  always measured. Counts are scaled up when the kernel had to multiplex.
+*/
+class PerfCounters
+{
+public:
+  PerfCounters();
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator= (const PerfCounters&) = delete;
+
+  // at least one event is counted
+  bool available() const;
+
+  void start();
+  PerfSample stop();
+
+private:
+  std::array<int, perf_event_count> fds_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+template <class Func>
+PerfSample measure(Func f)
+{
+  PerfCounters counters;
+
+  counters.start();
+  f();
+  return counters.stop();
+}
+
+// One line: time, IPC and every event per element, "-" where not counted
+void print_report(std::ostream& os, const std::string& name, const PerfSample& sample, size_t elements);
+
+// Column names matching print_report
+void print_header(std::ostream& os);
+
+} // namespace Bench
@@ -2,6 +2,10 @@
 
 #include <cstddef> // size_t
 #include <cassert> // assert
+#include <algorithm> // max
+#include <functional> // less
+
+#include "instrumentation.hpp"
 
 namespace Container {
 
@@ -22,6 +26,13 @@ class CList
   CListNode<T>* root_;
   std::size_t size_;
 
+  // merges two sorted null-terminated chains linked by next only, ties keep lhs first
+  template <class Compare>
+  static CListNode<T>* merge_chains(CListNode<T>* lhs, CListNode<T>* rhs, Compare& compare);
+
+  // makes the chain from head the whole list again, prev and the ring included
+  void relink(CListNode<T>* head);
+
 public:
   class Iterator
   {
@@ -75,6 +86,16 @@ public:
 
   Iterator insert(Iterator it, const T& value);
   void erase(Iterator it);
+
+  // Stable bottom-up merge sort, O(n log n). Nodes are relinked, values are
+  // neither copied nor moved and nothing is allocated.
+  template <class Compare = std::less<T>>
+  void sort(Compare compare = Compare());
+
+  // Moves every node of other, both sorted by compare, into this list
+  // keeping it sorted. Equal values of this list stay first.
+  template <class Compare = std::less<T>>
+  void merge(CList& other, Compare compare = Compare());
 };
 
 
@@ -204,6 +225,7 @@ template <class T>
 void CList<T>::push_back(const T& value)
 {
   auto node = new CListNode<T>(value);
+  Utility::Instrument::allocation(sizeof(CListNode<T>));
 
   if (!root_) {
     root_ = node;
@@ -224,6 +246,7 @@ template <class T>
 void CList<T>::push_front(const T& value)
 {
   auto node = new CListNode<T>(value);
+  Utility::Instrument::allocation(sizeof(CListNode<T>));
 
   if (!root_) {
     root_ = node;
@@ -288,6 +311,8 @@ T& CList<T>::operator[] (std::size_t index)
   for (std::size_t i = 0; i < index; ++i)
     node = node->next;
 
+  Utility::Instrument::step(index);
+
   return node->value;
 }
 
@@ -307,6 +332,7 @@ template <class T>
 typename CList<T>::Iterator CList<T>::insert(CList<T>::Iterator it, const T& value)
 {
 	auto node = new CListNode<T>(value);
+  Utility::Instrument::allocation(sizeof(CListNode<T>));
 
   node->prev = it.node_;
   node->next = it.node_->next;
@@ -332,4 +358,103 @@ void CList<T>::erase(CList<T>::Iterator it)
   delete it.node_;
 }
 
+template <class T>
+template <class Compare>
+void CList<T>::sort(Compare compare)
+{
+  if (size_ < 2)
+    return;
+
+  root_->prev->next = nullptr;
+
+  // runs[i] is empty or a sorted run of 2^i nodes, all older than runs[i - 1]
+  CListNode<T>* runs[64] = {};
+  std::size_t used = 0;
+
+  for (auto node = root_; node; ) {
+    auto run = node;
+    node = node->next;
+    run->next = nullptr;
+
+    std::size_t i = 0;
+    for (; i < used && runs[i]; ++i) {
+      run = merge_chains(runs[i], run, compare);
+      runs[i] = nullptr;
+    }
+
+    runs[i] = run;
+    used = std::max(used, i + 1);
+  }
+
+  CListNode<T>* head = nullptr;
+  for (std::size_t i = 0; i < used; ++i)
+    if (runs[i])
+      head = head ? merge_chains(runs[i], head, compare) : runs[i];
+
+  relink(head);
+}
+
+template <class T>
+template <class Compare>
+void CList<T>::merge(CList& other, Compare compare)
+{
+  if (&other == this || other.size_ == 0)
+    return;
+
+  if (size_ == 0) {
+    root_ = other.root_;
+  } else {
+    root_->prev->next = nullptr;
+    other.root_->prev->next = nullptr;
+
+    relink(merge_chains(root_, other.root_, compare));
+  }
+
+  size_ += other.size_;
+
+  other.root_ = nullptr;
+  other.size_ = 0;
+}
+
+template <class T>
+template <class Compare>
+CListNode<T>* CList<T>::merge_chains(CListNode<T>* lhs, CListNode<T>* rhs, Compare& compare)
+{
+  CListNode<T>* head = nullptr;
+  auto tail = &head;
+
+  while (lhs && rhs) {
+    Utility::Instrument::comparison();
+
+    if (compare(rhs->value, lhs->value)) {
+      *tail = rhs;
+      rhs = rhs->next;
+    } else {
+      *tail = lhs;
+      lhs = lhs->next;
+    }
+
+    tail = &(*tail)->next;
+  }
+
+  *tail = lhs ? lhs : rhs;
+
+  return head;
+}
+
+template <class T>
+void CList<T>::relink(CListNode<T>* head)
+{
+  auto last = head;
+
+  for (auto node = head->next; node; node = node->next) {
+    node->prev = last;
+    last = node;
+  }
+
+  root_ = head;
+  root_->prev = last;
+  last->next = root_;
+}
+
 } // namespace Container
@@ -0,0 +1,339 @@
+#include "compact_graph.hpp"
+#include "indexed_heap.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <cassert>
+
+namespace Container {
+
+auto CompactGraph::add_node(const std::string& label) -> Handle
+{
+  assert(nodes_.size() < std::numeric_limits<Handle>::max());
+
+  const auto handle = static_cast<Handle>(nodes_.size());
+
+  nodes_.push_back({label, {}, true});
+  index(handle);
+  ++alive_;
+
+  return handle;
+}
+
+auto CompactGraph::find(const std::string& label) const -> std::optional<Handle>
+{
+  const auto it = index_.find(label);
+
+  if (it != index_.end())
+    return it->second;
+
+  return std::nullopt;
+}
+
+bool CompactGraph::contains(Handle node) const
+{
+  return node < nodes_.size() && nodes_[node].alive;
+}
+
+const std::string& CompactGraph::label(Handle node) const { return nodes_[node].label; }
+
+size_t CompactGraph::node_count() const { return alive_; }
+
+auto CompactGraph::handle_bound() const -> Handle { return static_cast<Handle>(nodes_.size()); }
+
+
+void CompactGraph::add_adj(Handle from, Handle to, std::uint32_t coast)
+{
+  if (contains(from) && contains(to))
+    nodes_[from].adjacent.push_back({to, coast});
+}
+
+void CompactGraph::add_adj(const std::string& from, const std::string& to, std::uint32_t coast)
+{
+  const auto u = find(from);
+  const auto v = find(to);
+
+  if (u && v)
+    add_adj(*u, *v, coast);
+}
+
+
+void CompactGraph::del_node(Handle node)
+{
+  if (!contains(node))
+    return;
+
+  auto& dead = nodes_[node];
+
+  dead.alive = false;
+  unindex(node);
+
+  dead.adjacent = Adjacency();
+  --alive_;
+
+  // no edge may outlive its target
+  for (auto& other : nodes_) {
+    auto& adj = other.adjacent;
+
+    const auto last = std::remove_if(adj.begin(), adj.end(),
+      [node](const Arc& arc) {
+        return arc.target == node;
+      }
+    );
+
+    while (adj.end() != last)
+      adj.pop_back();
+  }
+}
+
+void CompactGraph::del_node(const std::string& label)
+{
+  if (const auto u = find(label))
+    del_node(*u);
+}
+
+
+void CompactGraph::del_adj(Handle from, Handle to)
+{
+  if (!contains(from))
+    return;
+
+  const auto it = find_arc(from, to);
+
+  if (it != nodes_[from].adjacent.end())
+    nodes_[from].adjacent.erase(it);
+}
+
+void CompactGraph::del_adj(const std::string& from, const std::string& to)
+{
+  const auto u = find(from);
+  const auto v = find(to);
+
+  if (u && v)
+    del_adj(*u, *v);
+}
+
+
+void CompactGraph::edit_node(Handle node, const std::string& new_label)
+{
+  if (!contains(node))
+    return;
+
+  auto& label = nodes_[node].label;
+
+  // hidden from unindex(), the old label goes to the next node bearing it
+  nodes_[node].alive = false;
+  unindex(node);
+  nodes_[node].alive = true;
+
+  label = new_label;
+  index(node);
+}
+
+void CompactGraph::edit_node(const std::string& label, const std::string& new_label)
+{
+  if (const auto u = find(label))
+    edit_node(*u, new_label);
+}
+
+
+void CompactGraph::edit_adj(Handle from, Handle to, std::uint32_t new_coast)
+{
+  if (!contains(from))
+    return;
+
+  const auto it = find_arc(from, to);
+
+  if (it != nodes_[from].adjacent.end())
+    nodes_[from].adjacent[it - nodes_[from].adjacent.begin()].coast = new_coast;
+}
+
+void CompactGraph::edit_adj(const std::string& from, const std::string& to, std::uint32_t new_coast)
+{
+  const auto u = find(from);
+  const auto v = find(to);
+
+  if (u && v)
+    edit_adj(*u, *v, new_coast);
+}
+
+
+auto CompactGraph::adjacent(Handle node) const -> const Adjacency& { return nodes_[node].adjacent; }
+
+auto CompactGraph::first(Handle node) const -> std::optional<Handle>
+{
+  if (!contains(node) || nodes_[node].adjacent.empty())
+    return std::nullopt;
+
+  return nodes_[node].adjacent.front().target;
+}
+
+auto CompactGraph::next(Handle node, Handle after) const -> std::optional<Handle>
+{
+  if (!contains(node))
+    return std::nullopt;
+
+  const auto it = find_arc(node, after);
+
+  if (it == nodes_[node].adjacent.end() || it + 1 == nodes_[node].adjacent.end())
+    return std::nullopt;
+
+  return (it + 1)->target;
+}
+
+
+size_t CompactGraph::radius() const
+{
+  constexpr auto unreachable = std::numeric_limits<size_t>::max();
+
+  std::vector<size_t> distances(nodes_.size());
+  IndexedHeap<size_t> heap(nodes_.size());
+
+  if (alive_ == 0)
+    return 0;
+
+  auto result = unreachable;
+
+  for (Handle source = 0; source < nodes_.size(); ++source) {
+    if (!nodes_[source].alive)
+      continue;
+
+    std::fill(distances.begin(), distances.end(), unreachable);
+    distances[source] = 0;
+    heap.push(source, 0);
+
+    while (!heap.empty()) {
+      const auto u = heap.top();
+      heap.pop();
+
+      for (const auto& arc : nodes_[u].adjacent) {
+        const auto candidate = distances[u] + arc.coast;
+
+        if (candidate < distances[arc.target]) {
+          distances[arc.target] = candidate;
+          heap.push_or_decrease(arc.target, candidate);
+        }
+      }
+    }
+
+    size_t eccentricity = 0;
+    for (Handle u = 0; u < nodes_.size(); ++u)
+      if (nodes_[u].alive)
+        eccentricity = std::max(eccentricity, distances[u]);
+
+    result = std::min(result, eccentricity);
+  }
+
+  return result;
+}
+
+
+GraphCsr CompactGraph::csr() const
+{
+  // deleted handles leave holes, live ones are renumbered densely
+  std::vector<std::uint32_t> id(nodes_.size());
+  std::uint32_t next_id = 0;
+
+  for (Handle u = 0; u < nodes_.size(); ++u)
+    id[u] = nodes_[u].alive ? next_id++ : 0;
+
+  GraphCsr result;
+  result.offsets.reserve(alive_ + 1);
+  result.labels.reserve(alive_);
+
+  for (const auto& node : nodes_) {
+    if (!node.alive)
+      continue;
+
+    result.labels.push_back(node.label);
+
+    for (const auto& arc : node.adjacent) {
+      result.targets.push_back(id[arc.target]);
+      result.weights.push_back(arc.coast);
+    }
+
+    result.offsets.push_back(result.targets.size());
+  }
+
+  return result;
+}
+
+CompactGraph CompactGraph::from_csr(const GraphCsr& csr)
+{
+  CompactGraph graph;
+  graph.nodes_.reserve(csr.node_count());
+
+  for (const auto& label : csr.labels)
+    graph.add_node(label);
+
+  for (Handle u = 0; u < csr.node_count(); ++u) {
+    auto& adjacent = graph.nodes_[u].adjacent;
+    adjacent.reserve(csr.offsets[u + 1] - csr.offsets[u]);
+
+    for (auto e = csr.offsets[u]; e < csr.offsets[u + 1]; ++e)
+      adjacent.push_back({csr.targets[e], csr.weights[e]});
+  }
+
+  return graph;
+}
+
+
+size_t CompactGraph::memory_usage() const
+{
+  auto result = sizeof(*this) + nodes_.capacity() * sizeof(Node);
+
+  for (const auto& node : nodes_) {
+    if (!node.adjacent.is_inline())
+      result += node.adjacent.capacity() * sizeof(Arc);
+
+    // short labels live in the string object itself
+    if (node.label.capacity() > std::string().capacity())
+      result += node.label.capacity() + 1;
+  }
+
+  // hash index: a slot and a control byte per entry
+  result += index_.capacity() * (sizeof(std::pair<const std::string, Handle>) + 1);
+
+  return result;
+}
+
+
+void CompactGraph::index(Handle node)
+{
+  const auto [it, fresh] = index_.try_emplace(nodes_[node].label, node);
+
+  if (!fresh && node < it->second)
+    it->second = node;
+}
+
+// node is no longer alive, its label passes to the lowest live handle left
+void CompactGraph::unindex(Handle node)
+{
+  const auto& label = nodes_[node].label;
+  const auto it = index_.find(label);
+
+  if (it == index_.end() || it->second != node)
+    return;
+
+  index_.erase(it);
+
+  for (Handle u = 0; u < nodes_.size(); ++u) {
+    if (nodes_[u].alive && nodes_[u].label == label) {
+      index_.try_emplace(label, u);
+      break;
+    }
+  }
+}
+
+auto CompactGraph::find_arc(Handle from, Handle to) const -> Adjacency::const_iterator
+{
+  const auto& adj = nodes_[from].adjacent;
+
+  return std::find_if(adj.begin(), adj.end(),
+    [to](const Arc& arc) {
+      return arc.target == to;
+    }
+  );
+}
+
+} // namespace Container
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef> // size_t
+#include <optional>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "flat_hash_map.hpp"
+#include "graph_csr.hpp"
+#include "small_vector.hpp"
+
+namespace Container {
+
+/*
+  Graph with the operations of Graph in compact form. Nodes are referred
+  to by handles, plain indices which stay valid until the node is deleted
+  and are never reused. An edge is {target, coast} in 8 bytes, the first
+  four of a node sit inline in the node, so low degree nodes need no
+  allocation for their edges. Label overloads look the handle up first.
+*/
+class CompactGraph
+{
+public:
+  using Handle = std::uint32_t;
+
+  struct Arc
+  {
+    Handle target;
+    std::uint32_t coast;
+  };
+
+  using Adjacency = SmallVector<Arc, 4>;
+
+  Handle add_node(const std::string& label);
+
+  // live node with label and the lowest handle
+  std::optional<Handle> find(const std::string& label) const;
+
+  bool contains(Handle node) const;
+  const std::string& label(Handle node) const;
+
+  size_t node_count() const;
+  Handle handle_bound() const;
+
+  void add_adj(Handle from, Handle to, std::uint32_t coast);
+  void add_adj(const std::string& from, const std::string& to, std::uint32_t coast);
+
+  void del_node(Handle node);
+  void del_node(const std::string& label);
+
+  void del_adj(Handle from, Handle to);
+  void del_adj(const std::string& from, const std::string& to);
+
+  void edit_node(Handle node, const std::string& new_label);
+  void edit_node(const std::string& label, const std::string& new_label);
+
+  void edit_adj(Handle from, Handle to, std::uint32_t new_coast);
+  void edit_adj(const std::string& from, const std::string& to, std::uint32_t new_coast);
+
+  const Adjacency& adjacent(Handle node) const;
+
+  // first adjacent node, the one after `after` in adjacency order
+  std::optional<Handle> first(Handle node) const;
+  std::optional<Handle> next(Handle node, Handle after) const;
+
+  template <class Predicate>
+  bool bfs_iterate(Handle start, Predicate p) const;
+
+  // smallest eccentricity, the same as Graph::radius()
+  size_t radius() const;
+
+  // live nodes in handle order
+  GraphCsr csr() const;
+  static CompactGraph from_csr(const GraphCsr& csr);
+
+  // bytes held by the graph, labels included
+  size_t memory_usage() const;
+
+private:
+  struct Node
+  {
+    std::string label;
+    Adjacency adjacent;
+    bool alive = true;
+  };
+
+  std::vector<Node> nodes_;
+  FlatHashMap<std::string, Handle> index_;
+  size_t alive_ = 0;
+
+  void index(Handle node);
+  void unindex(Handle node);
+
+  Adjacency::const_iterator find_arc(Handle from, Handle to) const;
+};
+
+
+template <class Predicate>
+bool CompactGraph::bfs_iterate(Handle start, Predicate p) const
+{
+  if (!contains(start))
+    return false;
+
+  std::vector<bool> visited(nodes_.size(), false);
+  std::queue<Handle> q;
+
+  q.push(start);
+  visited[start] = true;
+
+  while (!q.empty()) {
+    const auto node = q.front();
+    q.pop();
+
+    if (p(node))
+      return true;
+
+    for (const auto& arc : nodes_[node].adjacent) {
+      if (!visited[arc.target]) {
+        visited[arc.target] = true;
+        q.push(arc.target);
+      }
+    }
+  }
+
+  return false;
+}
+
+} // namespace Container
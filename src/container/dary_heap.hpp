@@ -0,0 +1,142 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <functional> // std::less
+#include <utility>
+#include <cassert>
+
+namespace Container {
+
+// Implicit d-ary heap in a vector. The top is the element which goes first
+// according to Compare, so with std::less it is a min-heap.
+template <class T, size_t Arity = 4, class Compare = std::less<T>>
+class DaryHeap
+{
+  static_assert(Arity >= 2, "heap arity must be at least 2");
+
+public:
+  explicit DaryHeap(const Compare& compare = Compare());
+
+  size_t size() const;
+  bool empty() const;
+
+  void reserve(size_t capacity);
+  void clear();
+
+  const T& top() const;
+
+  void push(const T& value);
+  void pop();
+
+private:
+  std::vector<T> data_;
+  Compare compare_;
+
+  size_t child(size_t parent) const;
+  size_t parent(size_t index) const;
+
+  void sift_up(size_t index);
+  void sift_down(size_t index);
+};
+
+
+template <class T, size_t Arity, class Compare>
+DaryHeap<T, Arity, Compare>::DaryHeap(const Compare& compare)
+  : compare_(compare)
+{ }
+
+
+template <class T, size_t Arity, class Compare>
+size_t DaryHeap<T, Arity, Compare>::size() const { return data_.size(); }
+
+template <class T, size_t Arity, class Compare>
+bool DaryHeap<T, Arity, Compare>::empty() const { return data_.empty(); }
+
+
+template <class T, size_t Arity, class Compare>
+void DaryHeap<T, Arity, Compare>::reserve(size_t capacity) { data_.reserve(capacity); }
+
+template <class T, size_t Arity, class Compare>
+void DaryHeap<T, Arity, Compare>::clear() { data_.clear(); }
+
+
+template <class T, size_t Arity, class Compare>
+const T& DaryHeap<T, Arity, Compare>::top() const
+{
+  assert(!data_.empty());
+  return data_.front();
+}
+
+
+template <class T, size_t Arity, class Compare>
+void DaryHeap<T, Arity, Compare>::push(const T& value)
+{
+  data_.push_back(value);
+  sift_up(data_.size() - 1);
+}
+
+template <class T, size_t Arity, class Compare>
+void DaryHeap<T, Arity, Compare>::pop()
+{
+  assert(!data_.empty());
+
+  data_.front() = std::move(data_.back());
+  data_.pop_back();
+
+  if (!data_.empty())
+    sift_down(0);
+}
+
+
+template <class T, size_t Arity, class Compare>
+size_t DaryHeap<T, Arity, Compare>::child(size_t parent) const { return parent * Arity + 1; }
+
+template <class T, size_t Arity, class Compare>
+size_t DaryHeap<T, Arity, Compare>::parent(size_t index) const { return (index - 1) / Arity; }
+
+
+// Both sifts move a hole instead of swapping, every element is moved once
+template <class T, size_t Arity, class Compare>
+void DaryHeap<T, Arity, Compare>::sift_up(size_t index)
+{
+  auto value = std::move(data_[index]);
+
+  while (index > 0 && compare_(value, data_[parent(index)])) {
+    data_[index] = std::move(data_[parent(index)]);
+    index = parent(index);
+  }
+
+  data_[index] = std::move(value);
+}
+
+// The last element almost always belongs near the bottom, so the hole goes
+// down to a leaf without comparing against it and then the value sifts up
+template <class T, size_t Arity, class Compare>
+void DaryHeap<T, Arity, Compare>::sift_down(size_t index)
+{
+  const auto size = data_.size();
+  auto value = std::move(data_[index]);
+
+  while (true) {
+    const auto first = child(index);
+
+    if (first >= size)
+      break;
+
+    const auto last = std::min(first + Arity, size);
+
+    auto best = first;
+    for (auto i = first + 1; i < last; ++i)
+      if (compare_(data_[i], data_[best]))
+        best = i;
+
+    data_[index] = std::move(data_[best]);
+    index = best;
+  }
+
+  data_[index] = std::move(value);
+  sift_up(index);
+}
+
+} // namespace Container
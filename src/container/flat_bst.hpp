@@ -1,25 +1,98 @@
 #pragma once
 
+#include <algorithm>
 #include <vector>
 #include <optional>
+#include <iterator>
+#include <limits>
+
+#include "instrumentation.hpp"
 
 namespace Container {
 
+namespace Detail
+{
+
+inline void prefetch(const void* address)
+{
+#if defined(__GNUC__)
+  __builtin_prefetch(address);
+#else
+  (void)address;
+#endif
+}
+
+} // namespace Detail
+
 template <class T>
 class FlatBst
 {
 public:
+  // In-order walk over the layout, forward only
+  class Iterator
+  {
+    friend class FlatBst;
+
+    const FlatBst* parent_ = nullptr;
+    size_t index_ = npos;
+
+    explicit Iterator(const FlatBst* parent, size_t index)
+      : parent_(parent), index_(index) { }
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    Iterator() = default;
+
+    bool operator== (const Iterator& it) const { return index_ == it.index_; }
+    bool operator!= (const Iterator& it) const { return index_ != it.index_; }
+
+    const T& operator* () const { return *parent_->data_[index_]; }
+    const T* operator-> () const { return &(operator*()); }
+
+    Iterator& operator++ () { index_ = parent_->successor(index_); return *this; }
+    Iterator operator++ (int) { auto it = *this; ++*this; return it; }
+  };
+
   virtual ~FlatBst() = default;
 
   void insert(const T& value);
   void insert(const std::initializer_list<T>& il);
 
+  size_t size() const;
+
+  Iterator begin() const;
+  Iterator end() const;
+
+  bool contains(const T& value) const;
+
+  // First key not less than value
+  Iterator lower_bound(const T& value) const;
+
+  // Keys of the top levels in order, at most parts - 1 of them. They cut
+  // the keys into about equal parts when the tree is balanced.
+  std::vector<T> splitters(size_t parts) const;
+
+  // Looks up every key of keys_begin..keys_end and writes one bool per key
+  // to out, in key order. Up to group descents are in flight at once, each
+  // goes down one level in turn and prefetches the node it visits next, so
+  // the cache misses of different keys overlap instead of adding up.
+  template <class ForwardIt, class OutputIt>
+  OutputIt find_many(ForwardIt keys_begin, ForwardIt keys_end, OutputIt out, size_t group = 32) const;
+
   template <class Func> void nlr_iterate(Func f);
   template <class Func> void lnr_iterate(Func f);
   template <class Func> void lrn_iterate(Func f);
 
 private:
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
   std::vector<std::optional<T>> data_;
+  size_t size_ = 0;
 
   size_t left(size_t parent) const;
   size_t right(size_t parent) const;
@@ -27,8 +100,13 @@ private:
 
   bool is_valid(size_t index) const;
 
+  size_t leftmost(size_t index) const;
+  size_t successor(size_t index) const;
+
   void insert(size_t index, const T& value);
 
+  void top_keys(size_t index, size_t levels, std::vector<T>& keys) const;
+
   template <class Func> void nlr_iterate(size_t index, Func f);
   template <class Func> void lnr_iterate(size_t index, Func f);
   template <class Func> void lrn_iterate(size_t index, Func f);
@@ -46,6 +124,144 @@ void FlatBst<T>::insert(const std::initializer_list<T>& il)
 }
 
 
+template <class T>
+size_t FlatBst<T>::size() const { return size_; }
+
+
+template <class T>
+auto FlatBst<T>::begin() const -> Iterator
+{
+  return Iterator(this, is_valid(0) ? leftmost(0) : npos);
+}
+
+template <class T>
+auto FlatBst<T>::end() const -> Iterator { return Iterator(this, npos); }
+
+
+template <class T>
+bool FlatBst<T>::contains(const T& value) const
+{
+  for (size_t index = 0; is_valid(index); ) {
+    const auto& node = *data_[index];
+    Utility::Instrument::step();
+
+    if (Utility::Instrument::less(value, node))
+      index = left(index);
+    else if (Utility::Instrument::less(node, value))
+      index = right(index);
+    else
+      return true;
+  }
+
+  return false;
+}
+
+template <class T>
+auto FlatBst<T>::lower_bound(const T& value) const -> Iterator
+{
+  auto found = npos;
+
+  for (size_t index = 0; is_valid(index); ) {
+    Utility::Instrument::step();
+
+    if (Utility::Instrument::less(*data_[index], value)) {
+      index = right(index);
+    } else {
+      found = index;
+      index = left(index);
+    }
+  }
+
+  return Iterator(this, found);
+}
+
+template <class T>
+std::vector<T> FlatBst<T>::splitters(size_t parts) const
+{
+  size_t levels = 0;
+  while ((size_t(2) << levels) <= parts)
+    ++levels;
+
+  std::vector<T> keys;
+  top_keys(0, levels, keys);
+
+  return keys;
+}
+
+template <class T> template <class ForwardIt, class OutputIt>
+OutputIt FlatBst<T>::find_many(ForwardIt keys_begin, ForwardIt keys_end, OutputIt out, size_t group) const
+{
+  // descents finish out of order, results are kept per chunk of keys
+  constexpr size_t chunk = 256;
+
+  struct Descent
+  {
+    ForwardIt key;
+    size_t index;
+    size_t position;
+  };
+
+  group = std::clamp<size_t>(group, 1, chunk);
+
+  std::vector<Descent> descents;
+  descents.reserve(group);
+
+  bool found[chunk];
+
+  while (keys_begin != keys_end) {
+    size_t started = 0;
+
+    for (; started < group && keys_begin != keys_end; ++started, ++keys_begin)
+      descents.push_back({keys_begin, 0, started});
+
+    for (size_t i = 0; !descents.empty(); ) {
+      auto& descent = descents[i];
+      auto done = true;
+      auto result = false;
+
+      if (is_valid(descent.index)) {
+        const auto& node = *data_[descent.index];
+        Utility::Instrument::step();
+
+        if (Utility::Instrument::less(*descent.key, node)) {
+          descent.index = left(descent.index);
+          done = false;
+        } else if (Utility::Instrument::less(node, *descent.key)) {
+          descent.index = right(descent.index);
+          done = false;
+        } else {
+          result = true;
+        }
+      }
+
+      if (!done) {
+        if (descent.index < data_.size())
+          Detail::prefetch(&data_[descent.index]);
+        ++i;
+      } else {
+        found[descent.position] = result;
+
+        // the slot takes the next key, or the last descent moves in
+        if (started < chunk && keys_begin != keys_end) {
+          descent = {keys_begin++, 0, started++};
+          ++i;
+        } else {
+          descent = descents.back();
+          descents.pop_back();
+        }
+      }
+
+      if (i >= descents.size())
+        i = 0;
+    }
+
+    out = std::copy(found, found + started, out);
+  }
+
+  return out;
+}
+
+
 template <class T> template <class Func>
 void FlatBst<T>::nlr_iterate(Func f) { return nlr_iterate(0, f); }
 
@@ -73,27 +289,75 @@ bool FlatBst<T>::is_valid(size_t index) const
 }
 
 
+template <class T>
+size_t FlatBst<T>::leftmost(size_t index) const
+{
+  while (is_valid(left(index)))
+    index = left(index);
+
+  return index;
+}
+
+template <class T>
+size_t FlatBst<T>::successor(size_t index) const
+{
+  if (is_valid(right(index)))
+    return leftmost(right(index));
+
+  // climb out of right subtrees, the parent of a left child is next
+  while (index != 0 && index % 2 == 0)
+    index = parent(index);
+
+  return index == 0 ? npos : parent(index);
+}
+
+
 template <class T>
 void FlatBst<T>::insert(size_t index, const T& value)
 {
-  if (data_.size() <= index)
+  const Utility::Instrument::Depth depth;
+  Utility::Instrument::step();
+
+  if (data_.size() <= index) {
+    const auto capacity = data_.capacity();
     data_.resize(index + 1);
 
-  if (!data_[index])
+    if (data_.capacity() != capacity)
+      Utility::Instrument::allocation(data_.capacity() * sizeof(std::optional<T>));
+  }
+
+  if (!data_[index]) {
     data_[index] = value;
-  else if (value < data_[index])
+    ++size_;
+    Utility::Instrument::move();
+  } else if (Utility::Instrument::less(value, data_[index]))
     insert(left(index), value);
-  else if (data_[index] < value)
+  else if (Utility::Instrument::less(data_[index], value))
     insert(right(index), value);
 }
 
 
+template <class T>
+void FlatBst<T>::top_keys(size_t index, size_t levels, std::vector<T>& keys) const
+{
+  if (levels == 0 || !is_valid(index))
+    return;
+
+  top_keys(left(index), levels - 1, keys);
+  keys.push_back(*data_[index]);
+  top_keys(right(index), levels - 1, keys);
+}
+
+
 template <class T> template <class Func>
 void FlatBst<T>::nlr_iterate(size_t index, Func f)
 {
   if (!is_valid(index))
     return;
 
+  const Utility::Instrument::Depth depth;
+  Utility::Instrument::step();
+
   f(data_[index].value());
 
   nlr_iterate(left(index), f);
@@ -106,6 +370,9 @@ void FlatBst<T>::lnr_iterate(size_t index, Func f)
   if (!is_valid(index))
     return;
 
+  const Utility::Instrument::Depth depth;
+  Utility::Instrument::step();
+
   lnr_iterate(left(index), f);
   f(data_[index].value());
   lnr_iterate(right(index), f);
@@ -117,6 +384,9 @@ void FlatBst<T>::lrn_iterate(size_t index, Func f)
   if (!is_valid(index))
     return;
 
+  const Utility::Instrument::Depth depth;
+  Utility::Instrument::step();
+
   lrn_iterate(left(index), f);
   lrn_iterate(right(index), f);
   f(data_[index].value());
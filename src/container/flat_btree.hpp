@@ -0,0 +1,333 @@
+#pragma once
+
+#include <vector>
+#include <array>
+#include <optional>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef> // size_t
+#include <iterator>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace Container::Detail {
+
+// One node of the tree, exactly NodeBytes in size and aligned to a cache line,
+// so a descent touches one cache line per level
+template <class T, size_t NodeBytes>
+struct alignas(64) FlatBtreeNode
+{
+  static constexpr size_t capacity = NodeBytes / sizeof(T);
+
+  std::array<T, capacity> keys;
+};
+
+
+// Number of keys in the node less than value (branchless, vectorizable)
+template <class T, size_t N>
+size_t node_rank(const std::array<T, N>& keys, const T& value)
+{
+  size_t rank = 0;
+  for (size_t i = 0; i < N; ++i)
+    rank += keys[i] < value;
+  return rank;
+}
+
+#if defined(__SSE2__)
+template <size_t N>
+size_t node_rank(const std::array<std::int32_t, N>& keys, const std::int32_t& value)
+{
+  static_assert(N % 4 == 0, "node must hold whole SSE registers");
+
+  const auto x = _mm_set1_epi32(value);
+  size_t rank = 0;
+
+  for (size_t i = 0; i < N; i += 4) {
+    const auto k = _mm_load_si128(reinterpret_cast<const __m128i*>(keys.data() + i));
+    const auto less = _mm_cmpgt_epi32(x, k); // keys[i] < value
+    rank += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(less)));
+  }
+
+  return rank;
+}
+#endif
+
+} // namespace Container::Detail
+
+namespace Container {
+
+// Static B+-tree (S+-tree layout). Every node fills NodeBytes, the leaf layer
+// keeps all keys sorted, inner layers keep the maximum of each child node.
+template <class T, size_t NodeBytes = 64>
+class FlatBtree
+{
+  using Node = Detail::FlatBtreeNode<T, NodeBytes>;
+
+  static_assert(Node::capacity > 1, "node must hold at least two keys");
+
+public:
+  // Random access over the leaf layer, i.e. over the keys in order
+  class Iterator
+  {
+    friend class FlatBtree;
+
+    const FlatBtree* parent_ = nullptr;
+    size_t index_ = 0;
+
+    explicit Iterator(const FlatBtree* parent, size_t index)
+      : parent_(parent), index_(index) { }
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    Iterator() = default;
+
+    bool operator== (const Iterator& it) const { return index_ == it.index_; }
+    bool operator!= (const Iterator& it) const { return index_ != it.index_; }
+    bool operator< (const Iterator& it) const { return index_ < it.index_; }
+
+    const T& operator* () const { return parent_->key(index_); }
+    const T* operator-> () const { return &(operator*()); }
+    const T& operator[] (difference_type n) const { return parent_->key(index_ + n); }
+
+    Iterator& operator++ () { ++index_; return *this; }
+    Iterator& operator-- () { --index_; return *this; }
+
+    Iterator operator++ (int) { auto it = *this; ++index_; return it; }
+    Iterator operator-- (int) { auto it = *this; --index_; return it; }
+
+    Iterator& operator+= (difference_type n) { index_ += n; return *this; }
+    Iterator& operator-= (difference_type n) { index_ -= n; return *this; }
+
+    Iterator operator+ (difference_type n) const { return Iterator(*this) += n; }
+    Iterator operator- (difference_type n) const { return Iterator(*this) -= n; }
+
+    difference_type operator- (const Iterator& it) const
+    {
+      return static_cast<difference_type>(index_) - static_cast<difference_type>(it.index_);
+    }
+  };
+
+  FlatBtree() = default;
+  FlatBtree(const std::initializer_list<T>& il);
+
+  template <class InputIt>
+  FlatBtree(InputIt first, InputIt last);
+
+  virtual ~FlatBtree() = default;
+
+  template <class InputIt>
+  void assign(InputIt first, InputIt last);
+
+  // Keys already in order, e.g. from another flat tree: nothing is sorted
+  template <class InputIt>
+  void assign_sorted(InputIt first, InputIt last);
+
+  size_t size() const;
+  bool empty() const;
+
+  Iterator begin() const;
+  Iterator end() const;
+
+  bool contains(const T& value) const;
+  std::optional<T> lower_bound(const T& value) const;
+
+  // At most parts - 1 keys in order, cutting the keys into equal parts
+  std::vector<T> splitters(size_t parts) const;
+
+  template <class Func> void range_iterate(const T& low, const T& high, Func f) const;
+  template <class Func> void lnr_iterate(Func f) const;
+
+private:
+  static constexpr size_t B = Node::capacity;
+
+  std::vector<Node> data_;
+  // index of the first node of every layer, leaves first, root last
+  std::vector<size_t> layers_;
+  size_t size_ = 0;
+
+  const T& key(size_t index) const;
+
+  void build(std::vector<T> sorted);
+  void build_unique(std::vector<T> sorted);
+
+  size_t lower_bound_index(const T& value) const;
+};
+
+
+template <class T, size_t NodeBytes>
+FlatBtree<T, NodeBytes>::FlatBtree(const std::initializer_list<T>& il)
+{
+  assign(il.begin(), il.end());
+}
+
+template <class T, size_t NodeBytes> template <class InputIt>
+FlatBtree<T, NodeBytes>::FlatBtree(InputIt first, InputIt last)
+{
+  assign(first, last);
+}
+
+
+template <class T, size_t NodeBytes> template <class InputIt>
+void FlatBtree<T, NodeBytes>::assign(InputIt first, InputIt last)
+{
+  std::vector<T> sorted(first, last);
+
+  std::sort(sorted.begin(), sorted.end());
+
+  build_unique(std::move(sorted));
+}
+
+template <class T, size_t NodeBytes> template <class InputIt>
+void FlatBtree<T, NodeBytes>::assign_sorted(InputIt first, InputIt last)
+{
+  build_unique(std::vector<T>(first, last));
+}
+
+template <class T, size_t NodeBytes>
+void FlatBtree<T, NodeBytes>::build_unique(std::vector<T> sorted)
+{
+  sorted.erase(std::unique(sorted.begin(), sorted.end(),
+    [](const T& lhs, const T& rhs) {
+      return !(lhs < rhs) && !(rhs < lhs);
+    }
+  ), sorted.end());
+
+  build(std::move(sorted));
+}
+
+
+template <class T, size_t NodeBytes>
+size_t FlatBtree<T, NodeBytes>::size() const { return size_; }
+
+template <class T, size_t NodeBytes>
+bool FlatBtree<T, NodeBytes>::empty() const { return size_ == 0; }
+
+
+template <class T, size_t NodeBytes>
+auto FlatBtree<T, NodeBytes>::begin() const -> Iterator { return Iterator(this, 0); }
+
+template <class T, size_t NodeBytes>
+auto FlatBtree<T, NodeBytes>::end() const -> Iterator { return Iterator(this, size_); }
+
+
+template <class T, size_t NodeBytes>
+bool FlatBtree<T, NodeBytes>::contains(const T& value) const
+{
+  const auto index = lower_bound_index(value);
+  return index < size_ && !(value < key(index));
+}
+
+template <class T, size_t NodeBytes>
+std::optional<T> FlatBtree<T, NodeBytes>::lower_bound(const T& value) const
+{
+  const auto index = lower_bound_index(value);
+
+  if (index == size_)
+    return std::nullopt;
+
+  return key(index);
+}
+
+
+template <class T, size_t NodeBytes>
+std::vector<T> FlatBtree<T, NodeBytes>::splitters(size_t parts) const
+{
+  std::vector<T> keys;
+
+  for (size_t part = 1; part < parts; ++part) {
+    const auto index = part * size_ / parts;
+
+    if (index > 0 && (keys.empty() || keys.back() < key(index)))
+      keys.push_back(key(index));
+  }
+
+  return keys;
+}
+
+
+template <class T, size_t NodeBytes> template <class Func>
+void FlatBtree<T, NodeBytes>::range_iterate(const T& low, const T& high, Func f) const
+{
+  for (auto index = lower_bound_index(low); index < size_ && !(high < key(index)); ++index)
+    f(key(index));
+}
+
+template <class T, size_t NodeBytes> template <class Func>
+void FlatBtree<T, NodeBytes>::lnr_iterate(Func f) const
+{
+  for (size_t index = 0; index < size_; ++index)
+    f(key(index));
+}
+
+
+template <class T, size_t NodeBytes>
+const T& FlatBtree<T, NodeBytes>::key(size_t index) const
+{
+  return data_[index / B].keys[index % B];
+}
+
+
+template <class T, size_t NodeBytes>
+void FlatBtree<T, NodeBytes>::build(std::vector<T> sorted)
+{
+  data_.clear();
+  layers_.clear();
+  size_ = sorted.size();
+
+  if (sorted.empty())
+    return;
+
+  // keys of the current layer; tails are padded with the last key, so the
+  // padding never counts as "less than" a value inside the tree
+  auto layer = std::move(sorted);
+
+  while (true) {
+    const auto nodes = (layer.size() + B - 1) / B;
+    layer.resize(nodes * B, layer.back());
+
+    layers_.push_back(data_.size());
+
+    for (size_t i = 0; i < nodes; ++i) {
+      Node node;
+      std::copy_n(layer.begin() + i * B, B, node.keys.begin());
+      data_.push_back(node);
+    }
+
+    if (nodes == 1)
+      break;
+
+    std::vector<T> upper;
+    upper.reserve(nodes);
+
+    for (size_t i = 0; i < nodes; ++i)
+      upper.push_back(layer[i * B + B - 1]);
+
+    layer = std::move(upper);
+  }
+}
+
+
+template <class T, size_t NodeBytes>
+size_t FlatBtree<T, NodeBytes>::lower_bound_index(const T& value) const
+{
+  if (size_ == 0 || key(size_ - 1) < value)
+    return size_;
+
+  size_t node = 0;
+
+  for (auto layer = layers_.size() - 1; layer > 0; --layer) {
+    const auto& keys = data_[layers_[layer] + node].keys;
+    node = node * B + Detail::node_rank(keys, value);
+  }
+
+  return node * B + Detail::node_rank(data_[node].keys, value);
+}
+
+} // namespace Container
@@ -0,0 +1,644 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef> // size_t
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <cassert>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace Container {
+
+// std::hash, plus lookup of std::string keys by std::string_view or const char*
+template <class Key>
+struct FlatHash : std::hash<Key> { };
+
+template <>
+struct FlatHash<std::string>
+{
+  using is_transparent = void;
+
+  size_t operator() (std::string_view key) const { return std::hash<std::string_view>()(key); }
+};
+
+} // namespace Container
+
+namespace Container::Detail {
+
+/*
+  Control byte per slot: empty, deleted, or the low 7 bits of the hash
+  when full. A probe compares a whole group of 16 control bytes against
+  those 7 bits at once, so slots are only touched on a likely match.
+  The first group is cloned past the end, a group may start at any slot.
+*/
+using HashCtrl = std::int8_t;
+
+constexpr HashCtrl hash_ctrl_empty = -128;
+constexpr HashCtrl hash_ctrl_deleted = -2;
+
+constexpr size_t hash_group_width = 16;
+
+// Bit i set for every matching control byte i of a group
+class HashGroupMask
+{
+public:
+  explicit HashGroupMask(std::uint32_t bits) : bits_(bits) { }
+
+  explicit operator bool() const { return bits_ != 0; }
+  size_t lowest() const { return static_cast<size_t>(__builtin_ctz(bits_)); }
+
+  HashGroupMask& operator++ () { bits_ &= bits_ - 1; return *this; }
+
+private:
+  std::uint32_t bits_;
+};
+
+class HashGroup
+{
+public:
+  explicit HashGroup(const HashCtrl* ctrl);
+
+  HashGroupMask match(HashCtrl h2) const;
+  HashGroupMask match_empty() const;
+  HashGroupMask match_empty_or_deleted() const;
+
+private:
+#if defined(__SSE2__)
+  __m128i ctrl_;
+#else
+  HashCtrl ctrl_[hash_group_width];
+#endif
+};
+
+#if defined(__SSE2__)
+inline HashGroup::HashGroup(const HashCtrl* ctrl)
+  : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)))
+{ }
+
+inline HashGroupMask HashGroup::match(HashCtrl h2) const
+{
+  return HashGroupMask(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+}
+
+inline HashGroupMask HashGroup::match_empty() const
+{
+  return match(hash_ctrl_empty);
+}
+
+// both are below -1, full bytes are not
+inline HashGroupMask HashGroup::match_empty_or_deleted() const
+{
+  return HashGroupMask(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl_)));
+}
+#else
+inline HashGroup::HashGroup(const HashCtrl* ctrl)
+{
+  std::memcpy(ctrl_, ctrl, hash_group_width);
+}
+
+inline HashGroupMask HashGroup::match(HashCtrl h2) const
+{
+  std::uint32_t bits = 0;
+  for (size_t i = 0; i < hash_group_width; ++i)
+    bits |= std::uint32_t(ctrl_[i] == h2) << i;
+  return HashGroupMask(bits);
+}
+
+inline HashGroupMask HashGroup::match_empty() const
+{
+  return match(hash_ctrl_empty);
+}
+
+inline HashGroupMask HashGroup::match_empty_or_deleted() const
+{
+  std::uint32_t bits = 0;
+  for (size_t i = 0; i < hash_group_width; ++i)
+    bits |= std::uint32_t(ctrl_[i] < -1) << i;
+  return HashGroupMask(bits);
+}
+#endif
+
+
+template <class Key, class Value>
+struct FlatMapPolicy
+{
+  using key_type = Key;
+  using slot_type = std::pair<const Key, Value>;
+  using value_type = std::pair<const Key, Value>;
+
+  static const Key& key(const slot_type& slot) { return slot.first; }
+
+  // the slot is dead right after, moving its key out is safe
+  static void transfer(slot_type* to, slot_type* from)
+  {
+    ::new (static_cast<void*>(to)) slot_type(std::move(const_cast<Key&>(from->first)), std::move(from->second));
+    std::destroy_at(from);
+  }
+};
+
+template <class Key>
+struct FlatSetPolicy
+{
+  using key_type = Key;
+  using slot_type = Key;
+  using value_type = const Key;
+
+  static const Key& key(const slot_type& slot) { return slot; }
+
+  static void transfer(slot_type* to, slot_type* from)
+  {
+    ::new (static_cast<void*>(to)) slot_type(std::move(*from));
+    std::destroy_at(from);
+  }
+};
+
+
+// Open addressing table shared by FlatHashMap and FlatHashSet
+template <class Policy, class Hash, class Eq>
+class FlatHashTable
+{
+  using slot_type = typename Policy::slot_type;
+
+public:
+  using key_type = typename Policy::key_type;
+  using value_type = typename Policy::value_type;
+
+  template <bool Const>
+  class Iterator
+  {
+    friend class FlatHashTable;
+    friend class Iterator<!Const>;
+
+    using Table = std::conditional_t<Const, const FlatHashTable, FlatHashTable>;
+    using Element = typename FlatHashTable::value_type;
+
+    Table* table_ = nullptr;
+    size_t index_ = 0;
+
+    explicit Iterator(Table* table, size_t index)
+      : table_(table), index_(index) { skip(); }
+
+    void skip()
+    {
+      while (index_ < table_->capacity_ && table_->ctrl_[index_] < 0)
+        ++index_;
+    }
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::remove_const_t<Element>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const Element*, Element*>;
+    using reference = std::conditional_t<Const, const Element&, Element&>;
+
+    Iterator() = default;
+    Iterator(const Iterator<false>& it) : table_(it.table_), index_(it.index_) { }
+
+    bool operator== (const Iterator& it) const { return index_ == it.index_; }
+    bool operator!= (const Iterator& it) const { return index_ != it.index_; }
+
+    reference operator* () const { return table_->slots_[index_]; }
+    pointer operator-> () const { return &(operator*()); }
+
+    Iterator& operator++ () { ++index_; skip(); return *this; }
+    Iterator operator++ (int) { auto it = *this; ++*this; return it; }
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+private:
+  template <class T, class = void>
+  struct IsTransparent : std::false_type { };
+
+  template <class T>
+  struct IsTransparent<T, std::void_t<typename T::is_transparent>> : std::true_type { };
+
+  template <class K>
+  using Transparent = std::enable_if_t<
+    IsTransparent<Hash>::value && IsTransparent<Eq>::value && !std::is_convertible_v<const K&, const_iterator>
+  >;
+
+public:
+  FlatHashTable() = default;
+
+  FlatHashTable(const FlatHashTable& other);
+  FlatHashTable(FlatHashTable&& other) noexcept;
+
+  FlatHashTable& operator= (const FlatHashTable& other);
+  FlatHashTable& operator= (FlatHashTable&& other) noexcept;
+
+  ~FlatHashTable();
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  size_t capacity() const { return capacity_; }
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, capacity_); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, capacity_); }
+
+  // room for count elements without rehashing
+  void reserve(size_t count);
+
+  // keeps the storage
+  void clear();
+
+  iterator find(const key_type& key) { return iterator(this, find_index(key)); }
+  const_iterator find(const key_type& key) const { return const_iterator(this, find_index(key)); }
+  bool contains(const key_type& key) const { return find_index(key) != capacity_; }
+  size_t erase(const key_type& key) { return erase_index(find_index(key)); }
+
+  void erase(const_iterator pos) { erase_index(pos.index_); }
+
+  // lookup by any type Hash and Eq accept, when both are transparent
+  template <class K, class = Transparent<K>>
+  iterator find(const K& key) { return iterator(this, find_index(key)); }
+
+  template <class K, class = Transparent<K>>
+  const_iterator find(const K& key) const { return const_iterator(this, find_index(key)); }
+
+  template <class K, class = Transparent<K>>
+  bool contains(const K& key) const { return find_index(key) != capacity_; }
+
+  template <class K, class = Transparent<K>>
+  size_t erase(const K& key) { return erase_index(find_index(key)); }
+
+protected:
+  // index of the slot with key, capacity_ if there is none
+  template <class K>
+  size_t find_index(const K& key) const;
+
+  // constructs the slot from args unless key is present
+  template <class K, class... Args>
+  std::pair<size_t, bool> emplace_key(const K& key, Args&&... args);
+
+  iterator make_iterator(size_t index) { return iterator(this, index); }
+
+private:
+  HashCtrl* ctrl_ = nullptr;
+  slot_type* slots_ = nullptr;
+  size_t capacity_ = 0; // 0 or a power of two of at least a group
+  size_t size_ = 0;
+  size_t growth_left_ = 0; // empty slots that may still fill up
+
+  static size_t mix(size_t hash);
+  static size_t capacity_for(size_t count);
+  size_t grown_capacity() const;
+
+  size_t mask() const { return capacity_ - 1; }
+  void set_ctrl(size_t index, HashCtrl ctrl);
+
+  size_t find_free(size_t hash) const;
+  size_t erase_index(size_t index);
+
+  void rehash(size_t capacity);
+  void release();
+};
+
+} // namespace Container::Detail
+
+namespace Container {
+
+/*
+  Hash map with open addressing in the SwissTable layout. Slots live in one
+  flat array beside an array of control bytes, a lookup scans 16 control
+  bytes with a single SIMD compare instead of chasing list nodes.
+
+  Erasure leaves a tombstone; iterators and references are invalidated by
+  any insertion that rehashes. Keys of std::string may be looked up by
+  std::string_view or const char* without building a string.
+*/
+template <class Key, class Value, class Hash = FlatHash<Key>, class Eq = std::equal_to<>>
+class FlatHashMap : public Detail::FlatHashTable<Detail::FlatMapPolicy<Key, Value>, Hash, Eq>
+{
+  using Base = Detail::FlatHashTable<Detail::FlatMapPolicy<Key, Value>, Hash, Eq>;
+
+public:
+  using mapped_type = Value;
+  using typename Base::iterator;
+
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args);
+
+  std::pair<iterator, bool> insert(const std::pair<const Key, Value>& value);
+
+  Value& operator[] (const Key& key);
+};
+
+
+template <class Key, class Hash = FlatHash<Key>, class Eq = std::equal_to<>>
+class FlatHashSet : public Detail::FlatHashTable<Detail::FlatSetPolicy<Key>, Hash, Eq>
+{
+  using Base = Detail::FlatHashTable<Detail::FlatSetPolicy<Key>, Hash, Eq>;
+
+public:
+  using typename Base::iterator;
+
+  std::pair<iterator, bool> insert(const Key& key);
+};
+
+
+
+template <class Key, class Value, class Hash, class Eq>
+template <class... Args>
+auto FlatHashMap<Key, Value, Hash, Eq>::try_emplace(const Key& key, Args&&... args) -> std::pair<iterator, bool>
+{
+  const auto [index, inserted] = this->emplace_key(key,
+    std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...)
+  );
+
+  return {this->make_iterator(index), inserted};
+}
+
+template <class Key, class Value, class Hash, class Eq>
+auto FlatHashMap<Key, Value, Hash, Eq>::insert(const std::pair<const Key, Value>& value) -> std::pair<iterator, bool>
+{
+  const auto [index, inserted] = this->emplace_key(value.first, value);
+  return {this->make_iterator(index), inserted};
+}
+
+template <class Key, class Value, class Hash, class Eq>
+Value& FlatHashMap<Key, Value, Hash, Eq>::operator[] (const Key& key)
+{
+  return try_emplace(key).first->second;
+}
+
+
+template <class Key, class Hash, class Eq>
+auto FlatHashSet<Key, Hash, Eq>::insert(const Key& key) -> std::pair<iterator, bool>
+{
+  const auto [index, inserted] = this->emplace_key(key, key);
+  return {this->make_iterator(index), inserted};
+}
+
+} // namespace Container
+
+namespace Container::Detail {
+
+template <class Policy, class Hash, class Eq>
+FlatHashTable<Policy, Hash, Eq>::FlatHashTable(const FlatHashTable& other)
+{
+  reserve(other.size_);
+
+  for (const auto& value : other)
+    emplace_key(Policy::key(value), value);
+}
+
+template <class Policy, class Hash, class Eq>
+FlatHashTable<Policy, Hash, Eq>::FlatHashTable(FlatHashTable&& other) noexcept
+  : ctrl_(std::exchange(other.ctrl_, nullptr))
+  , slots_(std::exchange(other.slots_, nullptr))
+  , capacity_(std::exchange(other.capacity_, 0))
+  , size_(std::exchange(other.size_, 0))
+  , growth_left_(std::exchange(other.growth_left_, 0))
+{ }
+
+template <class Policy, class Hash, class Eq>
+auto FlatHashTable<Policy, Hash, Eq>::operator= (const FlatHashTable& other) -> FlatHashTable&
+{
+  if (this != &other) {
+    clear();
+    reserve(other.size_);
+
+    for (const auto& value : other)
+      emplace_key(Policy::key(value), value);
+  }
+
+  return *this;
+}
+
+template <class Policy, class Hash, class Eq>
+auto FlatHashTable<Policy, Hash, Eq>::operator= (FlatHashTable&& other) noexcept -> FlatHashTable&
+{
+  if (this != &other) {
+    release();
+
+    ctrl_ = std::exchange(other.ctrl_, nullptr);
+    slots_ = std::exchange(other.slots_, nullptr);
+    capacity_ = std::exchange(other.capacity_, 0);
+    size_ = std::exchange(other.size_, 0);
+    growth_left_ = std::exchange(other.growth_left_, 0);
+  }
+
+  return *this;
+}
+
+template <class Policy, class Hash, class Eq>
+FlatHashTable<Policy, Hash, Eq>::~FlatHashTable() { release(); }
+
+
+template <class Policy, class Hash, class Eq>
+void FlatHashTable<Policy, Hash, Eq>::reserve(size_t count)
+{
+  if (count > size_ + growth_left_)
+    rehash(capacity_for(count));
+}
+
+template <class Policy, class Hash, class Eq>
+void FlatHashTable<Policy, Hash, Eq>::clear()
+{
+  if (capacity_ == 0)
+    return;
+
+  for (size_t i = 0; i < capacity_; ++i)
+    if (ctrl_[i] >= 0)
+      std::destroy_at(slots_ + i);
+
+  std::memset(ctrl_, hash_ctrl_empty, capacity_ + hash_group_width);
+
+  size_ = 0;
+  growth_left_ = capacity_ - capacity_ / 8;
+}
+
+
+// triangular probing over groups visits every group of a power of two table once
+template <class Policy, class Hash, class Eq>
+template <class K>
+size_t FlatHashTable<Policy, Hash, Eq>::find_index(const K& key) const
+{
+  if (size_ == 0)
+    return capacity_;
+
+  const auto hash = mix(Hash()(key));
+  const auto h2 = static_cast<HashCtrl>(hash & 0x7f);
+
+  auto pos = (hash >> 7) & mask();
+
+  for (size_t step = hash_group_width; ; step += hash_group_width) {
+    const HashGroup group(ctrl_ + pos);
+
+    for (auto match = group.match(h2); match; ++match) {
+      const auto index = (pos + match.lowest()) & mask();
+
+      if (Eq()(Policy::key(slots_[index]), key))
+        return index;
+    }
+
+    if (group.match_empty())
+      return capacity_;
+
+    pos = (pos + step) & mask();
+  }
+}
+
+template <class Policy, class Hash, class Eq>
+template <class K, class... Args>
+std::pair<size_t, bool> FlatHashTable<Policy, Hash, Eq>::emplace_key(const K& key, Args&&... args)
+{
+  if (const auto index = find_index(key); index != capacity_)
+    return {index, false};
+
+  const auto hash = mix(Hash()(key));
+  auto index = capacity_ == 0 ? 0 : find_free(hash);
+
+  // a tombstone is reused for free, an empty slot uses up growth
+  if (capacity_ == 0 || (growth_left_ == 0 && ctrl_[index] == hash_ctrl_empty)) {
+    rehash(grown_capacity());
+    index = find_free(hash);
+  }
+
+  ::new (static_cast<void*>(slots_ + index)) slot_type(std::forward<Args>(args)...);
+
+  growth_left_ -= ctrl_[index] == hash_ctrl_empty;
+  set_ctrl(index, static_cast<HashCtrl>(hash & 0x7f));
+  ++size_;
+
+  return {index, true};
+}
+
+
+template <class Policy, class Hash, class Eq>
+size_t FlatHashTable<Policy, Hash, Eq>::mix(size_t hash)
+{
+  // std::hash of integers is the identity, spread every bit over the others
+  std::uint64_t h = hash;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+
+  return static_cast<size_t>(h);
+}
+
+// load factor stays at most 7/8
+template <class Policy, class Hash, class Eq>
+size_t FlatHashTable<Policy, Hash, Eq>::capacity_for(size_t count)
+{
+  size_t capacity = hash_group_width;
+
+  while (capacity - capacity / 8 < count)
+    capacity *= 2;
+
+  return capacity;
+}
+
+// a table mostly full of tombstones is swept at the same capacity, never shrunk
+template <class Policy, class Hash, class Eq>
+size_t FlatHashTable<Policy, Hash, Eq>::grown_capacity() const
+{
+  if (capacity_ == 0)
+    return capacity_for(1);
+
+  return 2 * size_ < capacity_ - capacity_ / 8 ? capacity_ : 2 * capacity_;
+}
+
+template <class Policy, class Hash, class Eq>
+void FlatHashTable<Policy, Hash, Eq>::set_ctrl(size_t index, HashCtrl ctrl)
+{
+  ctrl_[index] = ctrl;
+
+  if (index < hash_group_width)
+    ctrl_[capacity_ + index] = ctrl;
+}
+
+template <class Policy, class Hash, class Eq>
+size_t FlatHashTable<Policy, Hash, Eq>::find_free(size_t hash) const
+{
+  auto pos = (hash >> 7) & mask();
+
+  for (size_t step = hash_group_width; ; step += hash_group_width) {
+    if (const auto free = HashGroup(ctrl_ + pos).match_empty_or_deleted())
+      return (pos + free.lowest()) & mask();
+
+    pos = (pos + step) & mask();
+  }
+}
+
+template <class Policy, class Hash, class Eq>
+size_t FlatHashTable<Policy, Hash, Eq>::erase_index(size_t index)
+{
+  if (index >= capacity_)
+    return 0;
+
+  std::destroy_at(slots_ + index);
+  set_ctrl(index, hash_ctrl_deleted);
+  --size_;
+
+  return 1;
+}
+
+
+// capacity may equal the current one, which only sweeps the tombstones out
+template <class Policy, class Hash, class Eq>
+void FlatHashTable<Policy, Hash, Eq>::rehash(size_t capacity)
+{
+  assert(capacity >= capacity_for(size_));
+
+  const auto old_ctrl = ctrl_;
+  const auto old_slots = slots_;
+  const auto old_capacity = capacity_;
+
+  ctrl_ = new HashCtrl[capacity + hash_group_width];
+  slots_ = std::allocator<slot_type>().allocate(capacity);
+  capacity_ = capacity;
+  growth_left_ = capacity - capacity / 8 - size_;
+
+  std::memset(ctrl_, hash_ctrl_empty, capacity + hash_group_width);
+
+  for (size_t i = 0; i < old_capacity; ++i) {
+    if (old_ctrl[i] < 0)
+      continue;
+
+    const auto hash = mix(Hash()(Policy::key(old_slots[i])));
+    const auto index = find_free(hash);
+
+    Policy::transfer(slots_ + index, old_slots + i);
+    set_ctrl(index, static_cast<HashCtrl>(hash & 0x7f));
+  }
+
+  if (old_capacity != 0) {
+    delete[] old_ctrl;
+    std::allocator<slot_type>().deallocate(old_slots, old_capacity);
+  }
+}
+
+template <class Policy, class Hash, class Eq>
+void FlatHashTable<Policy, Hash, Eq>::release()
+{
+  if (capacity_ == 0)
+    return;
+
+  clear();
+
+  delete[] ctrl_;
+  std::allocator<slot_type>().deallocate(slots_, capacity_);
+
+  ctrl_ = nullptr;
+  slots_ = nullptr;
+  capacity_ = 0;
+  growth_left_ = 0;
+}
+
+} // namespace Container::Detail
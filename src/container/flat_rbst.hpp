@@ -2,6 +2,10 @@
 
 #include <vector>
 #include <optional>
+#include <iterator>
+#include <limits>
+
+#include "instrumentation.hpp"
 
 namespace Container::Detail {
 
@@ -28,11 +32,53 @@ template <class T>
 class FlatRbst
 {
 public:
+  // In-order walk over the layout, forward only
+  class Iterator
+  {
+    friend class FlatRbst;
+
+    const FlatRbst* parent_ = nullptr;
+    size_t index_ = npos;
+
+    explicit Iterator(const FlatRbst* parent, size_t index)
+      : parent_(parent), index_(index) { }
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    Iterator() = default;
+
+    bool operator== (const Iterator& it) const { return index_ == it.index_; }
+    bool operator!= (const Iterator& it) const { return index_ != it.index_; }
+
+    const T& operator* () const { return parent_->data_[index_]->value; }
+    const T* operator-> () const { return &(operator*()); }
+
+    Iterator& operator++ () { index_ = parent_->successor(index_); return *this; }
+    Iterator operator++ (int) { auto it = *this; ++*this; return it; }
+  };
+
   virtual ~FlatRbst() = default;
 
   void insert(const T& value);
   void insert(const std::initializer_list<T>& il);
 
+  size_t size() const;
+
+  Iterator begin() const;
+  Iterator end() const;
+
+  // First key not less than value
+  Iterator lower_bound(const T& value) const;
+
+  // Keys of the top levels in order, at most parts - 1 of them. They cut
+  // the keys into about equal parts as the tree is balanced on average.
+  std::vector<T> splitters(size_t parts) const;
+
   template <class Func> void nlr_iterate(Func f);
   template <class Func> void lnr_iterate(Func f);
   template <class Func> void lrn_iterate(Func f);
@@ -41,6 +87,8 @@ private:
   using Container = std::vector<std::optional<Detail::FlatRbstNode<T>>>;
   using PairOfVectors = std::pair<std::vector<T>, std::vector<T>>;
 
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
   Container data_;
 
   size_t left(size_t parent) const;
@@ -49,6 +97,9 @@ private:
 
   bool is_valid(size_t index) const;
 
+  size_t leftmost(size_t index) const;
+  size_t successor(size_t index) const;
+
   size_t get_size(size_t index) const;
   void fix_size(size_t index);
 
@@ -57,6 +108,8 @@ private:
 
   PairOfVectors split(const T& value, size_t index);
 
+  void top_keys(size_t index, size_t levels, std::vector<T>& keys) const;
+
   template <class Func> void nlr_iterate(size_t index, Func f);
   template <class Func> void lnr_iterate(size_t index, Func f);
   template <class Func> void lrn_iterate(size_t index, Func f);
@@ -103,6 +156,53 @@ void FlatRbst<T>::insert(const std::initializer_list<T>& il)
 }
 
 
+template <class T>
+size_t FlatRbst<T>::size() const { return get_size(0); }
+
+
+template <class T>
+auto FlatRbst<T>::begin() const -> Iterator
+{
+  return Iterator(this, is_valid(0) ? leftmost(0) : npos);
+}
+
+template <class T>
+auto FlatRbst<T>::end() const -> Iterator { return Iterator(this, npos); }
+
+
+template <class T>
+auto FlatRbst<T>::lower_bound(const T& value) const -> Iterator
+{
+  auto found = npos;
+
+  for (size_t index = 0; is_valid(index); ) {
+    Utility::Instrument::step();
+
+    if (Utility::Instrument::less(data_[index]->value, value)) {
+      index = right(index);
+    } else {
+      found = index;
+      index = left(index);
+    }
+  }
+
+  return Iterator(this, found);
+}
+
+template <class T>
+std::vector<T> FlatRbst<T>::splitters(size_t parts) const
+{
+  size_t levels = 0;
+  while ((size_t(2) << levels) <= parts)
+    ++levels;
+
+  std::vector<T> keys;
+  top_keys(0, levels, keys);
+
+  return keys;
+}
+
+
 template <class T> template <class Func>
 void FlatRbst<T>::nlr_iterate(Func f) { return nlr_iterate(0, f); }
 
@@ -130,6 +230,29 @@ bool FlatRbst<T>::is_valid(size_t index) const
 }
 
 
+template <class T>
+size_t FlatRbst<T>::leftmost(size_t index) const
+{
+  while (is_valid(left(index)))
+    index = left(index);
+
+  return index;
+}
+
+template <class T>
+size_t FlatRbst<T>::successor(size_t index) const
+{
+  if (is_valid(right(index)))
+    return leftmost(right(index));
+
+  // climb out of right subtrees, the parent of a left child is next
+  while (index != 0 && index % 2 == 0)
+    index = parent(index);
+
+  return index == 0 ? npos : parent(index);
+}
+
+
 template <class T>
 size_t FlatRbst<T>::get_size(size_t index) const
 {
@@ -146,17 +269,25 @@ void FlatRbst<T>::fix_size(size_t index)
 template <class T>
 void FlatRbst<T>::insert(size_t index, const T& value)
 {
-  if (data_.size() <= index)
+  const Utility::Instrument::Depth depth;
+  Utility::Instrument::step();
+
+  if (data_.size() <= index) {
+    const auto capacity = data_.capacity();
     data_.resize(index + 1);
 
+    if (data_.capacity() != capacity)
+      Utility::Instrument::allocation(data_.capacity() * sizeof(typename Container::value_type));
+  }
+
   const auto rand = std::rand() % (get_size(index) + 1);
 
   if (rand == 0)
     insert_as_root(value, index);
-  else if (value < data_[index])
-    insert(value, left(index));
-  else if (data_[index] < value)
-    insert(value, right(index));
+  else if (Utility::Instrument::less(value, data_[index]))
+    insert(left(index), value);
+  else if (Utility::Instrument::less(data_[index], value))
+    insert(right(index), value);
 
   fix_size(index);
 }
@@ -167,12 +298,13 @@ void FlatRbst<T>::insert_as_root(const T& value, size_t index)
   const auto [smaller, bigger] = split(value, index);
 
   data_[index] = value;
+  Utility::Instrument::move();
 
   for (const auto& item : smaller)
-    insert(item, left(index));
+    insert(left(index), item);
 
   for (const auto& item : bigger)
-    insert(item, right(index));
+    insert(right(index), item);
 }
 
 
@@ -196,6 +328,9 @@ auto FlatRbst<T>::split(const T& value, size_t index) -> PairOfVectors
   std::vector<T> bigger;
 
   const auto parse = [&](/*optional<T>&*/ auto& item) {
+    Utility::Instrument::step();
+    Utility::Instrument::move();
+
     if (item < value)
       smaller.push_back(item->value);
     else if (value < item)
@@ -209,12 +344,27 @@ auto FlatRbst<T>::split(const T& value, size_t index) -> PairOfVectors
 }
 
 
+template <class T>
+void FlatRbst<T>::top_keys(size_t index, size_t levels, std::vector<T>& keys) const
+{
+  if (levels == 0 || !is_valid(index))
+    return;
+
+  top_keys(left(index), levels - 1, keys);
+  keys.push_back(data_[index]->value);
+  top_keys(right(index), levels - 1, keys);
+}
+
+
 template <class T> template <class Func>
 void FlatRbst<T>::nlr_iterate(size_t index, Func f)
 {
   if (!is_valid(index))
     return;
 
+  const Utility::Instrument::Depth depth;
+  Utility::Instrument::step();
+
   f(data_[index]->value);
 
   nlr_iterate(left(index), f);
@@ -227,6 +377,9 @@ void FlatRbst<T>::lnr_iterate(size_t index, Func f)
   if (!is_valid(index))
     return;
 
+  const Utility::Instrument::Depth depth;
+  Utility::Instrument::step();
+
   lnr_iterate(left(index), f);
   f(data_[index]->value);
   lnr_iterate(right(index), f);
@@ -238,6 +391,9 @@ void FlatRbst<T>::lrn_iterate(size_t index, Func f)
   if (!is_valid(index))
     return;
 
+  const Utility::Instrument::Depth depth;
+  Utility::Instrument::step();
+
   lrn_iterate(left(index), f);
   lrn_iterate(right(index), f);
   f(data_[index]->value);
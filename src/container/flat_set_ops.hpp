@@ -0,0 +1,204 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef> // size_t
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "flat_btree.hpp"
+#include "thread_pool.hpp"
+
+namespace Container::Detail {
+
+enum class SetOperation { Union, Intersection, Difference };
+
+template <class Iterator>
+constexpr bool is_random_access_v = std::is_base_of_v<std::random_access_iterator_tag,
+  typename std::iterator_traits<Iterator>::iterator_category>;
+
+// First key of tree not less than value
+template <class Tree, class T>
+auto set_seek(const Tree& tree, const T& value)
+{
+  if constexpr (is_random_access_v<decltype(tree.begin())>)
+    return std::lower_bound(tree.begin(), tree.end(), value);
+  else
+    return tree.lower_bound(value);
+}
+
+/*
+  First key from it on not less than value, all keys before it are less.
+  Random access keys are galloped over: steps of 1, 2, 4... then a binary
+  search in the last step, O(log d) for a skip of d. Tree walks take a few
+  steps and then search again from the root, O(depth) for any skip.
+*/
+template <class Tree, class Iterator, class T>
+Iterator set_skip(const Tree& tree, Iterator it, const T& value)
+{
+  const auto last = tree.end();
+
+  if constexpr (is_random_access_v<Iterator>) {
+    std::ptrdiff_t step = 1;
+
+    while (step < last - it && it[step] < value) {
+      it += step;
+      step *= 2;
+    }
+
+    return std::lower_bound(it, it + std::min(step, last - it), value);
+  } else {
+    for (int i = 0; i < 8; ++i, ++it)
+      if (it == last || !(*it < value))
+        return it;
+
+    return tree.lower_bound(value);
+  }
+}
+
+// The operation on the keys in [*low, *high), a null bound is open
+template <class T, class LhsTree, class RhsTree>
+void set_part(SetOperation operation, const LhsTree& lhs, const RhsTree& rhs,
+              const T* low, const T* high, std::vector<T>& out)
+{
+  auto a = low ? set_seek(lhs, *low) : lhs.begin();
+  auto b = low ? set_seek(rhs, *low) : rhs.begin();
+
+  const auto a_end = lhs.end();
+  const auto b_end = rhs.end();
+
+  const auto live = [high](const auto& it, const auto& last) {
+    return it != last && (!high || *it < *high);
+  };
+
+  while (live(a, a_end) && live(b, b_end)) {
+    if (*a < *b) {
+      if (operation == SetOperation::Intersection) {
+        a = set_skip(lhs, a, *b);
+      } else {
+        out.push_back(*a);
+        ++a;
+      }
+    } else if (*b < *a) {
+      if (operation == SetOperation::Union) {
+        out.push_back(*b);
+        ++b;
+      } else {
+        b = set_skip(rhs, b, *a);
+      }
+    } else {
+      if (operation != SetOperation::Difference)
+        out.push_back(*a);
+      ++a;
+      ++b;
+    }
+  }
+
+  if (operation != SetOperation::Intersection)
+    for (; live(a, a_end); ++a)
+      out.push_back(*a);
+
+  if (operation == SetOperation::Union)
+    for (; live(b, b_end); ++b)
+      out.push_back(*b);
+}
+
+/*
+  The key space is cut by splitters taken from both trees, every part is a
+  task of the shared thread pool that seeks its first keys in both trees
+  and runs the operation up to the next cut. The parts are concatenated in
+  order and bulk-built.
+*/
+template <class LhsTree, class RhsTree>
+auto set_operation(SetOperation operation, const LhsTree& lhs, const RhsTree& rhs, size_t threads)
+{
+  using T = std::decay_t<decltype(*lhs.begin())>;
+
+  constexpr size_t min_part = 1 << 14;
+
+  threads = std::clamp<size_t>(std::min(threads, (lhs.size() + rhs.size()) / min_part), 1, 256);
+
+  std::vector<T> cuts;
+
+  if (threads > 1) {
+    const auto lhs_keys = lhs.splitters(threads);
+    const auto rhs_keys = rhs.splitters(threads);
+
+    std::vector<T> keys;
+    std::merge(lhs_keys.begin(), lhs_keys.end(), rhs_keys.begin(), rhs_keys.end(),
+               std::back_inserter(keys));
+
+    for (size_t part = 1; part < threads && !keys.empty(); ++part) {
+      const auto& key = keys[part * keys.size() / threads];
+
+      if (cuts.empty() || cuts.back() < key)
+        cuts.push_back(key);
+    }
+  }
+
+  const auto parts = cuts.size() + 1;
+  std::vector<std::vector<T>> results(parts);
+
+  const auto run = [&](size_t part) {
+    set_part(operation, lhs, rhs,
+             part > 0 ? &cuts[part - 1] : nullptr,
+             part < cuts.size() ? &cuts[part] : nullptr,
+             results[part]);
+  };
+
+  if (parts == 1) {
+    run(0);
+  } else {
+    Utility::TaskGroup group(Utility::ThreadPool::shared());
+
+    for (size_t part = 0; part < parts; ++part)
+      group.run([&run, part] { run(part); });
+
+    group.wait();
+  }
+
+  for (size_t part = 1; part < parts; ++part)
+    results[0].insert(results[0].end(), results[part].begin(), results[part].end());
+
+  FlatBtree<T> tree;
+  tree.assign_sorted(results[0].begin(), results[0].end());
+
+  return tree;
+}
+
+} // namespace Container::Detail
+
+namespace Container {
+
+/*
+  Set algebra over flat trees (FlatBst, FlatRbst, FlatBtree, mixed as
+  well), reading their in-order keys directly. Runs of keys that cannot be
+  in the result are skipped by galloping or by a search from the root, so
+  a small set against a large one costs about small * log(large). Large
+  inputs are split by key range across threads. The result is a
+  bulk-built FlatBtree.
+*/
+template <class LhsTree, class RhsTree>
+auto set_union(const LhsTree& lhs, const RhsTree& rhs,
+               size_t threads = std::thread::hardware_concurrency())
+{
+  return Detail::set_operation(Detail::SetOperation::Union, lhs, rhs, threads);
+}
+
+template <class LhsTree, class RhsTree>
+auto set_intersection(const LhsTree& lhs, const RhsTree& rhs,
+                      size_t threads = std::thread::hardware_concurrency())
+{
+  return Detail::set_operation(Detail::SetOperation::Intersection, lhs, rhs, threads);
+}
+
+// Keys of lhs not in rhs
+template <class LhsTree, class RhsTree>
+auto set_difference(const LhsTree& lhs, const RhsTree& rhs,
+                    size_t threads = std::thread::hardware_concurrency())
+{
+  return Detail::set_operation(Detail::SetOperation::Difference, lhs, rhs, threads);
+}
+
+} // namespace Container
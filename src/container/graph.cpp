@@ -1,10 +1,64 @@
 #include "graph.hpp"
+#include "flat_hash_map.hpp"
+#include "indexed_heap.hpp"
 
 #include <iterator>
-#include <unordered_map>
+#include <limits>
+#include <stdexcept>
 
 namespace Container {
 
+namespace {
+
+// Dijkstra from source over positions in data, stops once target is settled.
+// heap must be empty on entry.
+template <class Nodes, class NodeIndex>
+void settle(const Nodes& data, const NodeIndex& index,
+            size_t source, size_t target,
+            std::vector<size_t>& distances, IndexedHeap<size_t>& heap)
+{
+  std::fill(distances.begin(), distances.end(), std::numeric_limits<size_t>::max());
+
+  distances[source] = 0;
+  heap.push(source, 0);
+
+  while (!heap.empty()) {
+    const auto current = heap.top();
+    heap.pop();
+
+    Utility::Instrument::step();
+
+    if (current == target) {
+      heap.clear();
+      break;
+    }
+
+    // iteration over all neighboring nodes
+    for (const auto& adj : data[current]->adjacent) {
+      const auto node = adj.node.lock();
+
+      if (!node)
+        continue;
+
+      const auto next = index.find(node.get())->second;
+      const auto new_dist = distances[current] + adj.coast;
+
+      if (Utility::Instrument::less(new_dist, distances[next])) {
+        distances[next] = new_dist;
+        heap.push_or_decrease(next, new_dist);
+      }
+    }
+  }
+}
+
+// One block for the node and its reference counts, counted at its real size
+GraphNodePtr make_node(const std::string& label)
+{
+  return std::allocate_shared<GraphNode>(Utility::Instrument::CountingAllocator<GraphNode>(), label);
+}
+
+} // namespace
+
 GraphNode::GraphNode(const std::string& _label)
   : label(_label)
 { }
@@ -63,7 +117,7 @@ std::optional<size_t> Graph::next(const std::string& label, size_t index) const
 
 void Graph::add_node(const std::string& label)
 {
-  data_.push_back(std::make_shared<GraphNode>(label));
+  data_.push_back(make_node(label));
 }
 
 void Graph::add_adj(const std::string& from, const std::string& to, size_t coast)
@@ -103,7 +157,21 @@ GraphNodePtr Graph::vertex(const std::string& label, size_t index) const
 void Graph::del_node(const std::string& label)
 {
   const auto it = get_node(label);
+
+  if (it == data_.end())
+    return;
+
+  const auto node = *it;
   data_.erase(it);
+
+  // no adjacency may outlive its node
+  for (const auto& other : data_) {
+    other->adjacent.remove_if(
+      [&node](const auto& item) {
+        return item.node.lock() == node;
+      }
+    );
+  }
 }
 
 void Graph::del_adj(const std::string& from, const std::string& to)
@@ -113,7 +181,7 @@ void Graph::del_adj(const std::string& from, const std::string& to)
   if (it_from == data_.end() || it_from->get()->adjacent.empty())
     return;
 
-  const auto it_to = get_node(from);
+  const auto it_to = get_node(to);
 
   if (it_to == data_.end())
     return;
@@ -126,7 +194,8 @@ void Graph::del_adj(const std::string& from, const std::string& to)
     }
   );
 
-  adj.erase(it_adj);
+  if (it_adj != adj.end())
+    adj.erase(it_adj);
 }
 
 
@@ -158,22 +227,19 @@ void Graph::edit_adj(const std::string& from, const std::string& to, size_t new_
     }
   );
 
-  adj.erase(it_adj);
+  if (it_adj != adj.end())
+    it_adj->coast = new_coast;
 }
 
 
 size_t Graph::radius() const
 {
-  std::vector<size_t> distances;
-  distances.reserve(data_.size());
+  auto buffers = scratch();
+  const auto source = buffers.index.find(center(buffers).get())->second;
 
-  std::transform(data_.begin(), data_.end(), std::back_inserter(distances),
-    [from = center(), this](auto to) {
-      return shortest_path(from, to);
-    }
-  );
+  settle(data_, buffers.index, source, data_.size(), buffers.distances, buffers.heap);
 
-  return *std::max_element(distances.begin(), distances.end());
+  return *std::max_element(buffers.distances.begin(), buffers.distances.end());
 }
 
 
@@ -182,81 +248,110 @@ size_t Graph::shortest_path(const GraphNodePtr from, const GraphNodePtr to) cons
   if (from == to)
     return 0;
 
-  // Has the node been visited
-  std::unordered_map<std::string, bool> visited;
+  auto buffers = scratch();
+  const auto& index = buffers.index;
+
   // Minimal distance from node "from" to other nodes
-  std::unordered_map<std::string, size_t> distances;
+  const auto target = index.find(to.get())->second;
+  settle(data_, index, index.find(from.get())->second, target, buffers.distances, buffers.heap);
+
+  return buffers.distances[target];
+}
+
+GraphCsr Graph::csr() const
+{
+  GraphCsr result;
+
+  const auto index = node_index();
+
+  result.offsets.reserve(data_.size() + 1);
+  result.labels.reserve(data_.size());
 
   for (const auto& node : data_) {
-    visited[node->label] = false;
-    distances[node->label] = std::numeric_limits<size_t>::max();
-  }
+    result.labels.push_back(node->label);
+
+    for (const auto& adj : node->adjacent) {
+      const auto target = adj.node.lock();
+      const auto it = target ? index.find(target.get()) : index.end();
+
+      // edges to deleted nodes are dropped
+      if (it == index.end())
+        continue;
 
-  std::queue<GraphNodePtr> q;
-  q.push(from);
-  distances[from->label] = 0;
+      if (adj.coast > std::numeric_limits<std::uint32_t>::max())
+        throw std::overflow_error("Graph::csr: coast " + std::to_string(adj.coast) +
+                                  " of an edge from " + node->label + " does not fit 32 bits");
 
-  auto from_adj_to_queue = [&q](const auto& adj) {
-    for (const auto& item : adj) {
-      q.push(item.node.lock());
+      result.targets.push_back(static_cast<std::uint32_t>(it->second));
+      result.weights.push_back(static_cast<std::uint32_t>(adj.coast));
     }
-  };
 
-  while (!q.empty()) {
-    const auto current = q.front();
-    q.pop();
+    result.offsets.push_back(result.targets.size());
+  }
 
-    if (visited[current->label])
-      continue;
+  return result;
+}
 
-    // iteration over all neighboring nodes
-    for (const auto& adj : current->adjacent) {
-      const auto node = adj.node.lock();
 
-      // distance to current adj node
-      auto& current_dist = distances[node->label];
-      const auto new_dist = distances[current->label] + adj.coast;
+Graph Graph::from_csr(const GraphCsr& csr)
+{
+  Graph graph;
+  graph.data_.reserve(csr.node_count());
+
+  for (const auto& label : csr.labels)
+    graph.data_.push_back(make_node(label));
 
-      current_dist = std::min(current_dist, new_dist);
-    }
+  for (size_t u = 0; u < csr.node_count(); ++u) {
+    auto& adjacent = graph.data_[u]->adjacent;
 
-    visited[current->label] = true;
-    // push all neighboring nodes to queue
-    from_adj_to_queue(current->adjacent);
+    for (auto e = csr.offsets[u]; e < csr.offsets[u + 1]; ++e)
+      adjacent.emplace_back(graph.data_[csr.targets[e]], csr.weights[e]);
   }
 
-  return distances[to->label];
+  return graph;
 }
 
-GraphNodePtr Graph::center() const
+
+GraphNodePtr Graph::center(Scratch& scratch) const
 {
-  std::unordered_map<
-      GraphNodePtr, std::unordered_map<GraphNodePtr, size_t>
-  > distance_matrix;
+  // one full Dijkstra per node, the buffers are shared by all of them
+  size_t center = 0;
+  auto min_eccentricity = std::numeric_limits<size_t>::max();
+
+  for (size_t from = 0; from < data_.size(); ++from) {
+    settle(data_, scratch.index, from, data_.size(), scratch.distances, scratch.heap);
+
+    const auto eccentricity = *std::max_element(scratch.distances.begin(), scratch.distances.end());
 
-  for (const auto from : data_) {
-    for (const auto to : data_) {
-      distance_matrix[from][to] = shortest_path(from, to);
+    if (eccentricity < min_eccentricity) {
+      min_eccentricity = eccentricity;
+      center = from;
     }
   }
 
-  auto by_coast = [](const auto& lhs, const auto& rhs) {
-    return lhs.second < rhs.second;
-  };
+  return data_[center];
+}
 
-  std::unordered_map<GraphNodePtr, size_t> max_distances;
 
-  for (const auto& [from, to] : distance_matrix) {
-    const auto it = std::max_element(to.begin(), to.end(), by_coast);
-    max_distances[from] = it->second;
-  }
+auto Graph::node_index() const -> NodeIndex
+{
+  NodeIndex index;
+  index.reserve(data_.size());
+
+  for (size_t i = 0; i < data_.size(); ++i)
+    index.try_emplace(data_[i].get(), i);
 
-  return std::min_element(max_distances.begin(), max_distances.end(), by_coast)->first;
+  return index;
+}
+
+auto Graph::scratch() const -> Scratch
+{
+  return {node_index(), std::vector<size_t>(data_.size()), IndexedHeap<size_t>(data_.size())};
 }
 
 
 auto Graph::get_node(const std::string& label) const
-  -> std::vector<GraphNodePtr>::const_iterator
+  -> Nodes::const_iterator
 {
   return find_if(data_.begin(), data_.end(),
     [&label](const auto& node) {
@@ -266,7 +361,7 @@ auto Graph::get_node(const std::string& label) const
 }
 
 auto Graph::get_node(const std::string& label)
-  -> std::vector<GraphNodePtr>::iterator
+  -> Nodes::iterator
 {
   return find_if(data_.begin(), data_.end(),
     [&label](const auto& node) {
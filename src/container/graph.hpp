@@ -5,12 +5,16 @@
 #include <vector>
 #include <list>
 #include <queue>
-#include <unordered_map>
 #include <string>
 #include <optional>
 #include <algorithm>
 #include <memory>
 
+#include "flat_hash_map.hpp"
+#include "graph_csr.hpp"
+#include "indexed_heap.hpp"
+#include "instrumentation.hpp"
+
 namespace Container {
 
 struct GraphAdjacency;
@@ -20,7 +24,7 @@ struct GraphNode
   explicit GraphNode(const std::string& _label);
 
   std::string label;
-  std::list<GraphAdjacency> adjacent;
+  std::list<GraphAdjacency, Utility::Instrument::CountingAllocator<GraphAdjacency>> adjacent;
 };
 
 struct GraphAdjacency
@@ -56,49 +60,68 @@ public:
 
   size_t radius() const;
 
+  // Snapshot in compressed sparse row form, vertex ids follow insertion order.
+  // Throws std::overflow_error if a coast does not fit the 32 bit weights.
+  GraphCsr csr() const;
+  static Graph from_csr(const GraphCsr& csr);
+
 private:
-  std::vector<GraphNodePtr> data_;
+  using Nodes = std::vector<GraphNodePtr, Utility::Instrument::CountingAllocator<GraphNodePtr>>;
+  using NodeIndex = FlatHashMap<const GraphNode*, size_t>;
+
+  // State of one query: the position of every node in data_ and Dijkstra
+  // buffers sized to it. Every call makes its own, so const queries stay
+  // safe to run concurrently.
+  struct Scratch
+  {
+    NodeIndex index;
+    std::vector<size_t> distances;
+    IndexedHeap<size_t> heap;
+  };
+
+  Nodes data_;
+
+  // Position of every node in data_
+  NodeIndex node_index() const;
+  Scratch scratch() const;
 
   size_t shortest_path(const GraphNodePtr from, const GraphNodePtr to) const;
 
-  GraphNodePtr center() const;
+  GraphNodePtr center(Scratch& scratch) const;
 
-  std::vector<GraphNodePtr>::const_iterator get_node(const std::string& label) const;
-  std::vector<GraphNodePtr>::iterator get_node(const std::string& label);
+  Nodes::const_iterator get_node(const std::string& label) const;
+  Nodes::iterator get_node(const std::string& label);
 };
 
 
 template <class Predicate>
 bool Graph::bfs_iterate(size_t start_index, Predicate p) const
 {
-  if (data_.size() < start_index)
+  if (data_.size() <= start_index)
     return false;
 
-  std::unordered_map<std::string, bool> visited;
-  for (const auto& node : data_) {
-    visited[node->label] = false;
-  }
-
+  FlatHashSet<const GraphNode*> visited;
+  visited.reserve(data_.size());
 
   std::queue<GraphNodePtr> q;
   q.push(data_[start_index]);
 
-  visited[data_[start_index]->label] = true;
+  visited.insert(data_[start_index].get());
 
   while (!q.empty()) {
     const auto node = q.front();
     q.pop();
 
+    Utility::Instrument::step();
+
     if (p(node))
       return true;
 
     for (const auto& item : node->adjacent) {
       const auto adj_node = item.node.lock();
 
-      if (!visited[adj_node->label]) {
+      if (adj_node && visited.insert(adj_node.get()).second)
         q.push(adj_node);
-        visited[adj_node->label] = true;
-      }
     }
   }
 
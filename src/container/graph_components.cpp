@@ -0,0 +1,220 @@
+#include "graph_components.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+#include "parallel.hpp"
+
+namespace Container {
+
+namespace {
+
+class ConcurrentForest
+{
+  std::vector<std::atomic<std::uint32_t>> parent_;
+
+public:
+  explicit ConcurrentForest(size_t size)
+    : parent_(size)
+  {
+    for (size_t i = 0; i < size; ++i)
+      parent_[i].store(static_cast<std::uint32_t>(i), std::memory_order_relaxed);
+  }
+
+  // with path halving; racing halvings only ever point closer to the root
+  std::uint32_t find(std::uint32_t x)
+  {
+    while (true) {
+      auto p = parent_[x].load(std::memory_order_relaxed);
+      const auto gp = parent_[p].load(std::memory_order_relaxed);
+
+      if (p == gp)
+        return p;
+
+      parent_[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+      x = gp;
+    }
+  }
+
+  // the larger root always hangs under the smaller one
+  void link(std::uint32_t u, std::uint32_t v)
+  {
+    while (true) {
+      auto ru = find(u);
+      auto rv = find(v);
+
+      if (ru == rv)
+        return;
+
+      if (ru < rv)
+        std::swap(ru, rv);
+
+      auto expected = ru;
+      if (parent_[ru].compare_exchange_strong(expected, rv, std::memory_order_relaxed))
+        return;
+    }
+  }
+
+  std::uint32_t parent(std::uint32_t x) const { return parent_[x].load(std::memory_order_relaxed); }
+  void set_parent(std::uint32_t x, std::uint32_t p) { parent_[x].store(p, std::memory_order_relaxed); }
+};
+
+} // namespace
+
+
+GraphComponents weakly_connected_components(const GraphCsrView& graph, size_t threads)
+{
+  const auto n = graph.node_count();
+  threads = std::max<size_t>(1, std::min(threads, n / 1024 + 1));
+
+  ConcurrentForest forest(n);
+
+  const auto slice = [n, threads](size_t t) {
+    return std::make_pair(n * t / threads, n * (t + 1) / threads);
+  };
+
+  const auto compress = [&](size_t t) {
+    const auto [first, last] = slice(t);
+    for (auto u = first; u < last; ++u)
+      forest.set_parent(u, forest.find(u));
+  };
+
+  constexpr std::uint64_t sampled = 2;
+
+  Utility::for_each_index(threads, [&](size_t t) {
+    const auto [first, last] = slice(t);
+
+    for (auto u = first; u < last; ++u) {
+      const auto end = std::min(graph.offsets[u] + sampled, graph.offsets[u + 1]);
+
+      for (auto e = graph.offsets[u]; e < end; ++e)
+        forest.link(u, graph.targets[e]);
+    }
+  });
+
+  Utility::for_each_index(threads, compress);
+
+  Utility::for_each_index(threads, [&](size_t t) {
+    const auto [first, last] = slice(t);
+
+    for (auto u = first; u < last; ++u)
+      for (auto e = graph.offsets[u] + sampled; e < graph.offsets[u + 1]; ++e)
+        forest.link(u, graph.targets[e]);
+  });
+
+  Utility::for_each_index(threads, compress);
+
+  // roots are the smallest vertices, so numbering them in order is stable
+  GraphComponents result;
+  result.component.resize(n);
+
+  for (size_t u = 0; u < n; ++u) {
+    const auto root = forest.parent(u);
+    result.component[u] = root == u ? static_cast<std::uint32_t>(result.count++) : result.component[root];
+  }
+
+  return result;
+}
+
+
+GraphComponents strongly_connected_components(const GraphCsrView& graph)
+{
+  constexpr auto none = std::numeric_limits<std::uint32_t>::max();
+
+  const auto n = graph.node_count();
+
+  GraphComponents result;
+  result.component.assign(n, none);
+
+  std::vector<std::uint32_t> index(n, none);
+  std::vector<std::uint32_t> low(n, 0);
+  std::vector<std::uint32_t> stack;
+
+  // explicit call stack: vertex and the next edge to look at
+  std::vector<std::pair<std::uint32_t, std::uint64_t>> calls;
+
+  std::uint32_t counter = 0;
+
+  for (std::uint32_t root = 0; root < n; ++root) {
+    if (index[root] != none)
+      continue;
+
+    calls.push_back({root, graph.offsets[root]});
+    index[root] = low[root] = counter++;
+    stack.push_back(root);
+
+    while (!calls.empty()) {
+      auto& [u, e] = calls.back();
+
+      if (e < graph.offsets[u + 1]) {
+        const auto v = graph.targets[e++];
+
+        if (index[v] == none) {
+          index[v] = low[v] = counter++;
+          stack.push_back(v);
+          calls.push_back({v, graph.offsets[v]});
+        } else if (result.component[v] == none) {
+          // v is still on the stack
+          low[u] = std::min(low[u], index[v]);
+        }
+
+        continue;
+      }
+
+      const auto finished = u;
+      calls.pop_back();
+
+      if (low[finished] == index[finished]) {
+        const auto id = static_cast<std::uint32_t>(result.count++);
+        std::uint32_t v;
+
+        do {
+          v = stack.back();
+          stack.pop_back();
+          result.component[v] = id;
+        } while (v != finished);
+      }
+
+      if (!calls.empty()) {
+        const auto parent = calls.back().first;
+        low[parent] = std::min(low[parent], low[finished]);
+      }
+    }
+  }
+
+  return result;
+}
+
+
+std::optional<std::vector<std::uint32_t>> topological_order(const GraphCsrView& graph)
+{
+  const auto n = graph.node_count();
+
+  std::vector<std::uint32_t> in_degree(n, 0);
+  for (size_t e = 0; e < graph.edge_count(); ++e)
+    ++in_degree[graph.targets[e]];
+
+  // the result doubles as the queue
+  std::vector<std::uint32_t> order;
+  order.reserve(n);
+
+  for (std::uint32_t u = 0; u < n; ++u)
+    if (in_degree[u] == 0)
+      order.push_back(u);
+
+  for (size_t head = 0; head < order.size(); ++head) {
+    const auto u = order[head];
+
+    for (auto e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e)
+      if (--in_degree[graph.targets[e]] == 0)
+        order.push_back(graph.targets[e]);
+  }
+
+  if (order.size() != n)
+    return std::nullopt;
+
+  return order;
+}
+
+} // namespace Container
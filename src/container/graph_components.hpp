@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef> // size_t
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "graph_csr.hpp"
+
+namespace Container {
+
+struct GraphComponents
+{
+  std::vector<std::uint32_t> component; // vertex -> component id
+  size_t count = 0;
+};
+
+/*
+  Weakly connected components by parallel link-and-compress over a
+  union-find forest: every root links to the smaller root with a CAS, then
+  paths are compressed. The first neighbours of every vertex are linked
+  first (Afforest sampling), which leaves most of the remaining edges as
+  cheap same-root checks. Every pass is cut into threads slices that run
+  on the shared thread pool. Component ids are dense and ordered by the
+  smallest vertex of each component.
+*/
+GraphComponents weakly_connected_components(const GraphCsrView& graph,
+                                            size_t threads = std::thread::hardware_concurrency());
+
+// Iterative Tarjan; ids come out in reverse topological order of the condensation
+GraphComponents strongly_connected_components(const GraphCsrView& graph);
+
+// Kahn's algorithm, nullopt when the graph has a cycle
+std::optional<std::vector<std::uint32_t>> topological_order(const GraphCsrView& graph);
+
+} // namespace Container
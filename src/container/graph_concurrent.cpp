@@ -0,0 +1,495 @@
+#include "graph_concurrent.hpp"
+
+#include <algorithm>
+
+namespace Container {
+
+ConcurrentGraph::ConcurrentGraph(size_t max_nodes)
+  : segments_((max_nodes + segment_size - 1) / segment_size)
+{
+  for (auto& segment : segments_)
+    segment.store(nullptr, std::memory_order_relaxed);
+}
+
+ConcurrentGraph::~ConcurrentGraph()
+{
+  stop_compaction();
+
+  for (auto& segment : segments_) {
+    const auto nodes = segment.load(std::memory_order_relaxed);
+
+    if (!nodes)
+      continue;
+
+    for (size_t i = 0; i < segment_size; ++i)
+      free_chain(nodes[i].head.load(std::memory_order_relaxed));
+
+    delete[] nodes;
+  }
+
+  for (const auto& [epoch, block] : retired_)
+    free_chain(block);
+}
+
+
+auto ConcurrentGraph::node(Id id) const -> Node*
+{
+  if (id / segment_size >= segments_.size())
+    return nullptr;
+
+  const auto nodes = segments_[id / segment_size].load(std::memory_order_acquire);
+  return nodes ? &nodes[id % segment_size] : nullptr;
+}
+
+auto ConcurrentGraph::ensure_node(Id id) -> Node*
+{
+  auto& segment = segments_[id / segment_size];
+  auto nodes = segment.load(std::memory_order_acquire);
+
+  if (!nodes) {
+    const auto fresh = new Node[segment_size];
+
+    if (segment.compare_exchange_strong(nodes, fresh, std::memory_order_acq_rel))
+      nodes = fresh;
+    else
+      delete[] fresh;
+  }
+
+  return &nodes[id % segment_size];
+}
+
+
+std::uint64_t ConcurrentGraph::pin() const
+{
+  while (true) {
+    const auto epoch = epoch_.load();
+    pins_[epoch & 1].fetch_add(1);
+
+    if (epoch_.load() == epoch)
+      return epoch;
+
+    pins_[epoch & 1].fetch_sub(1);
+  }
+}
+
+void ConcurrentGraph::unpin(std::uint64_t epoch) const
+{
+  pins_[epoch & 1].fetch_sub(1);
+}
+
+
+// Claims a flight slot holding a lower bound of the version about to be
+// taken. Announcing before taking the version means a snapshot either sees
+// the announcement or gets a version below the change.
+size_t ConcurrentGraph::announce()
+{
+  static std::atomic<size_t> next_home{0};
+  thread_local const size_t home = next_home.fetch_add(1) % flight_slots;
+
+  const auto floor = clock_.load() + 1;
+
+  for (size_t i = home; ; i = (i + 1) % flight_slots) {
+    std::uint64_t expected = 0;
+
+    if (in_flight_[i].version.compare_exchange_strong(expected, floor))
+      return i;
+
+    if ((i + 1) % flight_slots == home)
+      std::this_thread::yield();
+  }
+}
+
+template <class Func>
+bool ConcurrentGraph::mutate(Func f)
+{
+  const auto epoch = pin();
+  const auto slot = announce();
+  const auto version = clock_.fetch_add(1) + 1;
+
+  const bool result = f(version);
+
+  in_flight_[slot].version.store(0, std::memory_order_release);
+  unpin(epoch);
+
+  return result;
+}
+
+
+std::optional<ConcurrentGraph::Id> ConcurrentGraph::add_node()
+{
+  const auto id = next_id_.fetch_add(1);
+
+  if (id >= segments_.size() * segment_size)
+    return std::nullopt;
+
+  const auto fresh = ensure_node(static_cast<Id>(id));
+
+  mutate([fresh](std::uint64_t version) {
+    fresh->added.store(version, std::memory_order_release);
+    return true;
+  });
+
+  return static_cast<Id>(id);
+}
+
+bool ConcurrentGraph::del_node(Id id)
+{
+  if (!live(id))
+    return false;
+
+  const auto target = node(id);
+
+  return mutate([target](std::uint64_t version) {
+    auto expected = alive;
+    return target->removed.compare_exchange_strong(expected, version, std::memory_order_acq_rel);
+  });
+}
+
+
+bool ConcurrentGraph::add_adj(Id from, Id to, std::uint32_t coast)
+{
+  if (!live(from) || !live(to))
+    return false;
+
+  return mutate([&](std::uint64_t version) {
+    append(*node(from), to, coast, version);
+    return true;
+  });
+}
+
+bool ConcurrentGraph::del_adj(Id from, Id to)
+{
+  if (!live(from))
+    return false;
+
+  return mutate([&](std::uint64_t version) {
+    return remove(*node(from), to, version);
+  });
+}
+
+bool ConcurrentGraph::edit_adj(Id from, Id to, std::uint32_t new_coast)
+{
+  if (!live(from) || !live(to))
+    return false;
+
+  // both halves carry the same version, no snapshot sees the edge missing
+  return mutate([&](std::uint64_t version) {
+    if (!remove(*node(from), to, version))
+      return false;
+
+    append(*node(from), to, new_coast, version);
+    return true;
+  });
+}
+
+
+bool ConcurrentGraph::live(Id id) const
+{
+  if (id >= next_id_.load(std::memory_order_acquire))
+    return false;
+
+  const auto n = node(id);
+
+  return n && n->added.load(std::memory_order_acquire) != 0 &&
+         n->removed.load(std::memory_order_acquire) == alive;
+}
+
+void ConcurrentGraph::append(Node& from, Id to, std::uint32_t coast, std::uint64_t version)
+{
+  constexpr std::uint32_t first_capacity = 4;
+  constexpr std::uint32_t max_capacity = 1 << 16;
+
+  while (true) {
+    const auto block = from.head.load(std::memory_order_acquire);
+
+    if (block) {
+      const auto slot = block->reserved.fetch_add(1, std::memory_order_acq_rel);
+
+      if (slot < block->capacity) {
+        auto& edge = block->edges[slot];
+        edge.target = to;
+        edge.coast = coast;
+        edge.added.store(version, std::memory_order_release);
+        return;
+      }
+    }
+
+    // full, sealed by compaction, or no block yet
+    std::lock_guard lock(from.mutex);
+
+    if (from.head.load(std::memory_order_acquire) != block)
+      continue;
+
+    const auto capacity = block ? std::min(block->capacity * 2, max_capacity) : first_capacity;
+    from.head.store(new Block(capacity, block), std::memory_order_release);
+  }
+}
+
+bool ConcurrentGraph::remove(Node& from, Id to, std::uint64_t version)
+{
+  std::lock_guard lock(from.mutex);
+
+  for (auto block = from.head.load(std::memory_order_acquire); block; block = block->next) {
+    const auto size = block->size();
+
+    for (std::uint32_t i = 0; i < size; ++i) {
+      auto& edge = block->edges[i];
+
+      // a slot being written may hold an edge added before this version
+      auto added = edge.added.load(std::memory_order_acquire);
+      while (added == 0) {
+        std::this_thread::yield();
+        added = edge.added.load(std::memory_order_acquire);
+      }
+
+      if (added > version || edge.target != to)
+        continue;
+
+      auto expected = alive;
+      if (edge.removed.compare_exchange_strong(expected, version, std::memory_order_acq_rel))
+        return true;
+    }
+  }
+
+  return false;
+}
+
+
+std::uint64_t ConcurrentGraph::version() const
+{
+  auto result = clock_.load();
+
+  for (const auto& flight : in_flight_) {
+    const auto v = flight.version.load();
+
+    if (v != 0 && v <= result)
+      result = v - 1;
+  }
+
+  return result;
+}
+
+auto ConcurrentGraph::snapshot() const -> Snapshot
+{
+  std::lock_guard lock(readers_mutex_);
+
+  const auto version = this->version();
+  const auto epoch = epoch_.load();
+  const auto bound = std::min<std::uint64_t>(next_id_.load(std::memory_order_acquire),
+                                             segments_.size() * segment_size);
+
+  reader_versions_.insert(version);
+  reader_epochs_.insert(epoch);
+
+  return Snapshot(this, version, epoch, static_cast<Id>(bound));
+}
+
+void ConcurrentGraph::release(std::uint64_t version, std::uint64_t epoch) const
+{
+  std::lock_guard lock(readers_mutex_);
+
+  reader_versions_.erase(reader_versions_.find(version));
+  reader_epochs_.erase(reader_epochs_.find(epoch));
+}
+
+
+void ConcurrentGraph::compact()
+{
+  std::lock_guard guard(compaction_mutex_);
+
+  // tombstones at or below horizon are invisible to every snapshot, open or future
+  std::uint64_t horizon;
+  {
+    std::lock_guard lock(readers_mutex_);
+    horizon = version();
+
+    if (!reader_versions_.empty())
+      horizon = std::min(horizon, *reader_versions_.begin());
+  }
+
+  const auto dead = [this, horizon](Id id) {
+    const auto n = node(id);
+    return !n || n->removed.load(std::memory_order_acquire) <= horizon;
+  };
+
+  const auto dropped = [&](const Edge& edge) {
+    const auto added = edge.added.load(std::memory_order_acquire);
+    return added != 0 && (edge.removed.load(std::memory_order_acquire) <= horizon || dead(edge.target));
+  };
+
+  std::vector<Block*> retired;
+  std::vector<Block*> chain;
+
+  const auto bound = std::min<std::uint64_t>(next_id_.load(), segments_.size() * segment_size);
+
+  for (Id id = 0; id < bound; ++id) {
+    const auto n = node(id);
+    const auto head = n ? n->head.load(std::memory_order_acquire) : nullptr;
+
+    if (!head)
+      continue;
+
+    // only compaction frees blocks, so the chain can be scanned unlocked
+    bool needed = head->next != nullptr || dead(id);
+    for (std::uint32_t i = 0; !needed && i < head->size(); ++i)
+      needed = dropped(head->edges[i]);
+
+    if (!needed)
+      continue;
+
+    std::lock_guard lock(n->mutex);
+
+    // seal the newest block, late appenders move to a new one
+    const auto sealed = n->head.load(std::memory_order_acquire);
+    const auto reserved = std::min(sealed->reserved.fetch_add(sealed->capacity, std::memory_order_acq_rel),
+                                   sealed->capacity);
+
+    chain.clear();
+    for (auto block = sealed; block; block = block->next)
+      chain.push_back(block);
+
+    std::reverse(chain.begin(), chain.end());
+
+    std::vector<const Edge*> kept;
+
+    if (!dead(id)) {
+      for (const auto block : chain) {
+        const auto size = block == sealed ? reserved : block->capacity;
+
+        for (std::uint32_t i = 0; i < size; ++i) {
+          const auto& edge = block->edges[i];
+
+          // appenders that reserved a slot before the seal finish first
+          while (edge.added.load(std::memory_order_acquire) == 0)
+            std::this_thread::yield();
+
+          if (!dropped(edge))
+            kept.push_back(&edge);
+        }
+      }
+    }
+
+    Block* fresh = nullptr;
+
+    if (!kept.empty()) {
+      fresh = new Block(static_cast<std::uint32_t>(std::max<size_t>(4, kept.size() * 2)), nullptr);
+
+      for (std::uint32_t i = 0; i < kept.size(); ++i) {
+        auto& edge = fresh->edges[i];
+        edge.target = kept[i]->target;
+        edge.coast = kept[i]->coast;
+        edge.removed.store(kept[i]->removed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        edge.added.store(kept[i]->added.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+
+      fresh->reserved.store(static_cast<std::uint32_t>(kept.size()), std::memory_order_relaxed);
+    }
+
+    n->head.store(fresh, std::memory_order_release);
+    retired.push_back(sealed);
+  }
+
+  // readers and writers that start from now on only see the new heads
+  const auto epoch = epoch_.fetch_add(1);
+
+  // writers of this epoch may still hold an old head
+  while (pins_[epoch & 1].load() != 0)
+    std::this_thread::yield();
+
+  for (const auto block : retired)
+    retired_.push_back({epoch, block});
+
+  std::uint64_t oldest;
+  {
+    std::lock_guard lock(readers_mutex_);
+    oldest = reader_epochs_.empty() ? epoch + 1 : *reader_epochs_.begin();
+  }
+
+  const auto keep = std::partition(retired_.begin(), retired_.end(),
+    [oldest](const auto& item) {
+      return item.first >= oldest;
+    }
+  );
+
+  for (auto it = keep; it != retired_.end(); ++it)
+    free_chain(it->second);
+
+  retired_.erase(keep, retired_.end());
+}
+
+
+void ConcurrentGraph::start_compaction(std::chrono::milliseconds period)
+{
+  std::lock_guard lock(compactor_mutex_);
+
+  if (compactor_.joinable())
+    return;
+
+  compactor_stop_ = false;
+  compactor_ = std::thread([this, period] {
+    std::unique_lock lock(compactor_mutex_);
+
+    while (!compactor_cv_.wait_for(lock, period, [this] { return compactor_stop_; })) {
+      lock.unlock();
+      compact();
+      lock.lock();
+    }
+  });
+}
+
+void ConcurrentGraph::stop_compaction()
+{
+  {
+    std::lock_guard lock(compactor_mutex_);
+    compactor_stop_ = true;
+  }
+
+  compactor_cv_.notify_all();
+
+  if (compactor_.joinable())
+    compactor_.join();
+}
+
+
+void ConcurrentGraph::free_chain(Block* block)
+{
+  while (block) {
+    const auto next = block->next;
+    delete block;
+    block = next;
+  }
+}
+
+
+ConcurrentGraph::Snapshot::Snapshot(const ConcurrentGraph* graph, std::uint64_t version,
+                                    std::uint64_t epoch, Id bound)
+  : graph_(graph), version_(version), epoch_(epoch), bound_(bound)
+{ }
+
+ConcurrentGraph::Snapshot::Snapshot(Snapshot&& other) noexcept
+  : graph_(other.graph_), version_(other.version_), epoch_(other.epoch_), bound_(other.bound_)
+{
+  other.graph_ = nullptr;
+}
+
+ConcurrentGraph::Snapshot::~Snapshot()
+{
+  if (graph_)
+    graph_->release(version_, epoch_);
+}
+
+bool ConcurrentGraph::Snapshot::contains(Id id) const
+{
+  if (id >= bound_)
+    return false;
+
+  const auto n = graph_->node(id);
+
+  if (!n)
+    return false;
+
+  const auto added = n->added.load(std::memory_order_acquire);
+  return added != 0 && added <= version_ && n->removed.load(std::memory_order_acquire) > version_;
+}
+
+} // namespace Container
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef> // size_t
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace Container {
+
+/*
+  Mutable graph for many writers and readers at once, over dense node ids.
+
+  Every change gets a version from a global clock. Nodes and edges carry
+  the version that added them and the one that removed them (tombstones),
+  a snapshot sees exactly the changes up to its version however long it
+  traverses. Writers announce the version they are about to take, a
+  snapshot stops right below the oldest change still in flight, so it never
+  sees a later change without the earlier ones and no writer waits for
+  another.
+
+  Edges of a node live in a chain of blocks. Appending reserves a slot of
+  the newest block with a fetch_add, only a full block takes the node lock
+  to grow the chain. Deleting edges takes the node lock as well.
+
+  compact() drops tombstones no snapshot can see any more and merges the
+  chains into a single block. Replaced blocks are freed once every
+  snapshot that could still be reading them is gone.
+*/
+class ConcurrentGraph
+{
+  struct Edge;
+  struct Block;
+  struct Node;
+
+public:
+  using Id = std::uint32_t;
+
+  class Snapshot;
+
+  explicit ConcurrentGraph(size_t max_nodes = size_t(1) << 22);
+  ~ConcurrentGraph();
+
+  ConcurrentGraph(const ConcurrentGraph&) = delete;
+  ConcurrentGraph& operator= (const ConcurrentGraph&) = delete;
+
+  // nullopt once max_nodes ids are given out
+  std::optional<Id> add_node();
+  bool del_node(Id node);
+
+  // false when a node is missing or deleted
+  bool add_adj(Id from, Id to, std::uint32_t coast);
+  bool del_adj(Id from, Id to);
+  bool edit_adj(Id from, Id to, std::uint32_t new_coast);
+
+  Snapshot snapshot() const;
+
+  // Last version visible to new snapshots
+  std::uint64_t version() const;
+
+  void compact();
+
+  // compact() every period on a background thread until stop_compaction()
+  void start_compaction(std::chrono::milliseconds period);
+  void stop_compaction();
+
+private:
+  static constexpr std::uint64_t alive = std::numeric_limits<std::uint64_t>::max();
+  static constexpr size_t segment_size = 4096;
+
+  std::vector<std::atomic<Node*>> segments_;
+  std::atomic<std::uint64_t> next_id_{0};
+
+  static constexpr size_t flight_slots = 64;
+
+  struct alignas(64) Flight
+  {
+    std::atomic<std::uint64_t> version{0}; // lower bound of a change in flight, 0 if free
+  };
+
+  std::atomic<std::uint64_t> clock_{0};
+  mutable std::array<Flight, flight_slots> in_flight_;
+
+  // open snapshots, oldest version and epoch first
+  mutable std::mutex readers_mutex_;
+  mutable std::multiset<std::uint64_t> reader_versions_;
+  mutable std::multiset<std::uint64_t> reader_epochs_;
+  std::atomic<std::uint64_t> epoch_{0};
+
+  // writers in flight per epoch parity, a writer may hold a head pointer
+  mutable std::atomic<std::uint64_t> pins_[2] = {};
+
+  // blocks replaced by compaction and the epoch they left in
+  std::mutex compaction_mutex_;
+  std::vector<std::pair<std::uint64_t, Block*>> retired_;
+
+  std::thread compactor_;
+  std::mutex compactor_mutex_;
+  std::condition_variable compactor_cv_;
+  bool compactor_stop_ = false;
+
+  Node* node(Id id) const;
+  Node* ensure_node(Id id);
+
+  // runs f with a fresh version, announced while f runs
+  template <class Func>
+  bool mutate(Func f);
+
+  size_t announce();
+
+  std::uint64_t pin() const;
+  void unpin(std::uint64_t epoch) const;
+
+  bool live(Id id) const;
+  void append(Node& from, Id to, std::uint32_t coast, std::uint64_t version);
+  bool remove(Node& from, Id to, std::uint64_t version);
+
+  void release(std::uint64_t version, std::uint64_t epoch) const;
+  static void free_chain(Block* block);
+};
+
+
+// Consistent read-only view. Keeps the blocks it may read alive, so it
+// should not outlive the traversal it is taken for.
+class ConcurrentGraph::Snapshot
+{
+public:
+  Snapshot(Snapshot&& other) noexcept;
+  Snapshot& operator= (Snapshot&&) = delete;
+  ~Snapshot();
+
+  std::uint64_t version() const { return version_; }
+
+  // ids below id_bound() were given out when the snapshot was taken
+  Id id_bound() const { return bound_; }
+  bool contains(Id node) const;
+
+  // f(target, coast) for every edge of node
+  template <class Func>
+  void for_each_adj(Id node, Func f) const;
+
+  template <class Predicate>
+  bool bfs_iterate(Id start, Predicate p) const;
+
+private:
+  friend class ConcurrentGraph;
+
+  const ConcurrentGraph* graph_;
+  std::uint64_t version_;
+  std::uint64_t epoch_;
+  Id bound_;
+
+  Snapshot(const ConcurrentGraph* graph, std::uint64_t version, std::uint64_t epoch, Id bound);
+};
+
+
+struct ConcurrentGraph::Edge
+{
+  std::atomic<std::uint64_t> added{0}; // 0 while the slot is being written
+  std::atomic<std::uint64_t> removed{alive};
+  Id target = 0;
+  std::uint32_t coast = 0;
+};
+
+struct ConcurrentGraph::Block
+{
+  explicit Block(std::uint32_t _capacity, Block* _next)
+    : capacity(_capacity), next(_next), edges(new Edge[_capacity])
+  { }
+
+  const std::uint32_t capacity;
+  std::atomic<std::uint32_t> reserved{0};
+  Block* next; // older edges
+  std::unique_ptr<Edge[]> edges;
+
+  std::uint32_t size() const { return std::min(reserved.load(std::memory_order_acquire), capacity); }
+};
+
+struct ConcurrentGraph::Node
+{
+  std::atomic<Block*> head{nullptr};
+  std::atomic<std::uint64_t> added{0};
+  std::atomic<std::uint64_t> removed{alive};
+  std::mutex mutex;
+};
+
+
+template <class Func>
+void ConcurrentGraph::Snapshot::for_each_adj(Id node, Func f) const
+{
+  if (!contains(node))
+    return;
+
+  for (auto block = graph_->node(node)->head.load(std::memory_order_acquire); block; block = block->next) {
+    const auto size = block->size();
+
+    for (std::uint32_t i = 0; i < size; ++i) {
+      const auto& edge = block->edges[i];
+      const auto added = edge.added.load(std::memory_order_acquire);
+
+      if (added == 0 || added > version_ || edge.removed.load(std::memory_order_acquire) <= version_)
+        continue;
+
+      if (contains(edge.target))
+        f(edge.target, edge.coast);
+    }
+  }
+}
+
+template <class Predicate>
+bool ConcurrentGraph::Snapshot::bfs_iterate(Id start, Predicate p) const
+{
+  if (!contains(start))
+    return false;
+
+  std::vector<bool> visited(bound_, false);
+  std::queue<Id> q;
+
+  q.push(start);
+  visited[start] = true;
+
+  while (!q.empty()) {
+    const auto node = q.front();
+    q.pop();
+
+    if (p(node))
+      return true;
+
+    for_each_adj(node, [&](Id target, std::uint32_t) {
+      if (!visited[target]) {
+        visited[target] = true;
+        q.push(target);
+      }
+    });
+  }
+
+  return false;
+}
+
+} // namespace Container
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef> // size_t
+#include <string>
+#include <vector>
+
+namespace Container {
+
+// Non-owning compressed sparse row adjacency over dense vertex ids.
+// Edges of u are [offsets[u], offsets[u + 1]) in targets/weights.
+struct GraphCsrView
+{
+  size_t nodes = 0;
+  const std::uint64_t* offsets = nullptr;
+  const std::uint32_t* targets = nullptr;
+  const std::uint32_t* weights = nullptr;
+
+  size_t node_count() const { return nodes; }
+  size_t edge_count() const { return nodes == 0 ? 0 : offsets[nodes]; }
+
+  size_t degree(size_t u) const { return offsets[u + 1] - offsets[u]; }
+};
+
+
+// Owning compressed sparse row graph, vertex i is labels[i]
+struct GraphCsr
+{
+  std::vector<std::uint64_t> offsets{0};
+  std::vector<std::uint32_t> targets;
+  std::vector<std::uint32_t> weights;
+  std::vector<std::string> labels;
+
+  size_t node_count() const { return offsets.size() - 1; }
+  size_t edge_count() const { return targets.size(); }
+
+  GraphCsrView view() const
+  {
+    return {node_count(), offsets.data(), targets.data(), weights.data()};
+  }
+};
+
+} // namespace Container
@@ -0,0 +1,377 @@
+#include "graph_file.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <fstream>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Container {
+
+namespace {
+
+constexpr std::uint64_t section_alignment = 64;
+
+std::uint64_t align_up(std::uint64_t pos)
+{
+  return (pos + section_alignment - 1) / section_alignment * section_alignment;
+}
+
+
+// Streaming form of graph_file_checksum
+class Hasher
+{
+  static constexpr std::uint64_t prime = 0x100000001b3ULL;
+
+  std::uint64_t hash_ = 0xcbf29ce484222325ULL;
+  std::uint64_t size_ = 0;
+  std::uint8_t tail_[8];
+  size_t tail_size_ = 0;
+
+  void word(std::uint64_t w)
+  {
+    hash_ = (hash_ ^ w) * prime;
+    hash_ ^= hash_ >> 29;
+  }
+
+public:
+  void update(const std::uint8_t* data, size_t size)
+  {
+    size_ += size;
+
+    while (size > 0 && tail_size_ != 0) {
+      tail_[tail_size_++] = *data++;
+      --size;
+
+      if (tail_size_ == 8) {
+        std::uint64_t w;
+        std::memcpy(&w, tail_, 8);
+        word(w);
+        tail_size_ = 0;
+      }
+    }
+
+    for (; size >= 8; data += 8, size -= 8) {
+      std::uint64_t w;
+      std::memcpy(&w, data, 8);
+      word(w);
+    }
+
+    for (; size > 0; --size)
+      tail_[tail_size_++] = *data++;
+  }
+
+  std::uint64_t digest() const
+  {
+    auto result = *this;
+
+    std::uint64_t w = 0;
+    std::memcpy(&w, tail_, tail_size_);
+    result.word(w);
+    result.word(size_);
+
+    return result.hash_;
+  }
+};
+
+
+// Writes the bytes, pads the file up to pos and hashes both
+class SectionWriter
+{
+  std::ofstream& out_;
+  Hasher& hasher_;
+  std::uint64_t pos_;
+
+public:
+  SectionWriter(std::ofstream& out, Hasher& hasher, std::uint64_t pos)
+    : out_(out), hasher_(hasher), pos_(pos)
+  { }
+
+  void pad_to(std::uint64_t pos)
+  {
+    static const std::uint8_t zeros[section_alignment] = {};
+
+    while (pos_ < pos) {
+      const auto count = std::min<std::uint64_t>(pos - pos_, section_alignment);
+      write(zeros, count);
+    }
+  }
+
+  void write(const void* data, size_t size)
+  {
+    out_.write(static_cast<const char*>(data), size);
+    hasher_.update(static_cast<const std::uint8_t*>(data), size);
+    pos_ += size;
+  }
+
+  template <class T>
+  void write(const std::vector<T>& v) { write(v.data(), v.size() * sizeof(T)); }
+};
+
+} // namespace
+
+
+std::uint64_t graph_file_checksum(const std::uint8_t* data, size_t size)
+{
+  Hasher hasher;
+  hasher.update(data, size);
+  return hasher.digest();
+}
+
+
+bool write_graph_file(const GraphCsr& csr, const std::string& path)
+{
+  const auto n = csr.node_count();
+  const auto m = csr.edge_count();
+
+  std::vector<std::uint64_t> label_index;
+  label_index.reserve(n + 1);
+  label_index.push_back(0);
+
+  for (const auto& label : csr.labels)
+    label_index.push_back(label_index.back() + label.size());
+
+  GraphFileHeader header{};
+  std::memcpy(header.magic, GraphFileHeader::magic_value, sizeof(header.magic));
+  header.version = GraphFileHeader::current_version;
+  header.header_size = sizeof(GraphFileHeader);
+  header.node_count = n;
+  header.edge_count = m;
+
+  header.offsets_pos = align_up(sizeof(GraphFileHeader));
+  header.targets_pos = align_up(header.offsets_pos + (n + 1) * sizeof(std::uint64_t));
+  header.weights_pos = align_up(header.targets_pos + m * sizeof(std::uint32_t));
+  header.label_index_pos = align_up(header.weights_pos + m * sizeof(std::uint32_t));
+  header.labels_pos = align_up(header.label_index_pos + (n + 1) * sizeof(std::uint64_t));
+  header.labels_size = label_index.back();
+  header.file_size = header.labels_pos + header.labels_size;
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+
+  if (!out)
+    return false;
+
+  // placeholder, rewritten once the checksum is known
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  Hasher hasher;
+  SectionWriter writer(out, hasher, sizeof(header));
+
+  writer.pad_to(header.offsets_pos);
+  writer.write(csr.offsets);
+
+  writer.pad_to(header.targets_pos);
+  writer.write(csr.targets);
+
+  writer.pad_to(header.weights_pos);
+  writer.write(csr.weights);
+
+  writer.pad_to(header.label_index_pos);
+  writer.write(label_index);
+
+  writer.pad_to(header.labels_pos);
+  for (const auto& label : csr.labels)
+    writer.write(label.data(), label.size());
+
+  header.checksum = hasher.digest();
+
+  out.seekp(0);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  return static_cast<bool>(out.flush());
+}
+
+bool write_graph_file(const Graph& graph, const std::string& path)
+{
+  return write_graph_file(graph.csr(), path);
+}
+
+
+std::optional<MappedGraph> MappedGraph::open(const std::string& path, Check check)
+{
+  const auto fd = ::open(path.c_str(), O_RDONLY);
+
+  if (fd < 0)
+    return std::nullopt;
+
+  struct stat st;
+
+  if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(GraphFileHeader)) {
+    ::close(fd);
+    return std::nullopt;
+  }
+
+  const auto size = static_cast<size_t>(st.st_size);
+  const auto address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+
+  // the mapping keeps the file alive
+  ::close(fd);
+
+  if (address == MAP_FAILED)
+    return std::nullopt;
+
+  MappedGraph graph(static_cast<const std::uint8_t*>(address), size);
+  const auto& h = graph.header();
+
+  const auto section_ok = [&h, size](std::uint64_t pos, std::uint64_t bytes) {
+    return pos % section_alignment == 0 && pos >= h.header_size
+        && pos <= size && bytes <= size - pos;
+  };
+
+  const auto n = h.node_count;
+  const auto m = h.edge_count;
+
+  const bool header_ok =
+       std::memcmp(h.magic, GraphFileHeader::magic_value, sizeof(h.magic)) == 0
+    && h.version == GraphFileHeader::current_version
+    && h.header_size == sizeof(GraphFileHeader)
+    && h.file_size == size
+    && n < std::numeric_limits<std::uint32_t>::max()
+    && m < size
+    && section_ok(h.offsets_pos, (n + 1) * sizeof(std::uint64_t))
+    && section_ok(h.targets_pos, m * sizeof(std::uint32_t))
+    && section_ok(h.weights_pos, m * sizeof(std::uint32_t))
+    && section_ok(h.label_index_pos, (n + 1) * sizeof(std::uint64_t))
+    && section_ok(h.labels_pos, h.labels_size);
+
+  if (!header_ok)
+    return std::nullopt;
+
+  if (check == Check::Full && !graph.validate())
+    return std::nullopt;
+
+  return graph;
+}
+
+
+MappedGraph::MappedGraph(const std::uint8_t* data, size_t size)
+  : data_(data)
+  , size_(size)
+{ }
+
+MappedGraph::MappedGraph(MappedGraph&& other) noexcept
+  : data_(other.data_)
+  , size_(other.size_)
+{
+  other.data_ = nullptr;
+  other.size_ = 0;
+}
+
+MappedGraph& MappedGraph::operator= (MappedGraph&& other) noexcept
+{
+  if (this != &other) {
+    if (data_)
+      ::munmap(const_cast<std::uint8_t*>(data_), size_);
+
+    data_ = other.data_;
+    size_ = other.size_;
+
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+
+  return *this;
+}
+
+MappedGraph::~MappedGraph()
+{
+  if (data_)
+    ::munmap(const_cast<std::uint8_t*>(data_), size_);
+}
+
+
+size_t MappedGraph::node_count() const { return header().node_count; }
+
+size_t MappedGraph::edge_count() const { return header().edge_count; }
+
+
+std::string_view MappedGraph::label(size_t node) const
+{
+  const auto index = section<std::uint64_t>(header().label_index_pos);
+  const auto labels = section<char>(header().labels_pos);
+
+  return {labels + index[node], index[node + 1] - index[node]};
+}
+
+
+GraphCsrView MappedGraph::view() const
+{
+  return {
+    node_count(),
+    section<std::uint64_t>(header().offsets_pos),
+    section<std::uint32_t>(header().targets_pos),
+    section<std::uint32_t>(header().weights_pos),
+  };
+}
+
+
+bool MappedGraph::validate() const
+{
+  const auto& h = header();
+
+  if (graph_file_checksum(data_ + sizeof(GraphFileHeader), size_ - sizeof(GraphFileHeader)) != h.checksum)
+    return false;
+
+  const auto n = h.node_count;
+  const auto g = view();
+
+  if (g.offsets[0] != 0 || g.offsets[n] != h.edge_count)
+    return false;
+
+  for (size_t u = 0; u < n; ++u)
+    if (g.offsets[u] > g.offsets[u + 1])
+      return false;
+
+  for (size_t e = 0; e < h.edge_count; ++e)
+    if (g.targets[e] >= n)
+      return false;
+
+  const auto index = section<std::uint64_t>(h.label_index_pos);
+
+  if (index[0] != 0 || index[n] != h.labels_size)
+    return false;
+
+  for (size_t u = 0; u < n; ++u)
+    if (index[u] > index[u + 1])
+      return false;
+
+  return true;
+}
+
+
+GraphCsr MappedGraph::to_csr() const
+{
+  const auto g = view();
+  const auto n = g.node_count();
+  const auto m = g.edge_count();
+
+  GraphCsr result;
+  result.offsets.assign(g.offsets, g.offsets + n + 1);
+  result.targets.assign(g.targets, g.targets + m);
+  result.weights.assign(g.weights, g.weights + m);
+
+  result.labels.reserve(n);
+  for (size_t u = 0; u < n; ++u)
+    result.labels.emplace_back(label(u));
+
+  return result;
+}
+
+
+const GraphFileHeader& MappedGraph::header() const
+{
+  return *reinterpret_cast<const GraphFileHeader*>(data_);
+}
+
+template <class T>
+const T* MappedGraph::section(std::uint64_t pos) const
+{
+  return reinterpret_cast<const T*>(data_ + pos);
+}
+
+} // namespace Container
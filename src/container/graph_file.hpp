@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef> // size_t
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "graph.hpp"
+#include "graph_csr.hpp"
+
+namespace Container {
+
+/*
+  Binary graph file, version 1, native (little) endian:
+
+    header                      GraphFileHeader, 128 bytes
+    offsets                     uint64[node_count + 1]
+    targets                     uint32[edge_count]
+    weights                     uint32[edge_count]
+    label index                 uint64[node_count + 1], offsets into labels
+    labels                      concatenated label bytes
+
+  Every section starts on a 64 byte boundary, so the arrays can be used
+  in place once the file is mapped. The checksum covers every byte after
+  the header.
+*/
+struct GraphFileHeader
+{
+  static constexpr char magic_value[8] = {'C', 'P', 'P', 'A', 'G', 'R', 'P', 'H'};
+  static constexpr std::uint32_t current_version = 1;
+
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t header_size;
+
+  std::uint64_t node_count;
+  std::uint64_t edge_count;
+
+  std::uint64_t offsets_pos;
+  std::uint64_t targets_pos;
+  std::uint64_t weights_pos;
+  std::uint64_t label_index_pos;
+  std::uint64_t labels_pos;
+  std::uint64_t labels_size;
+
+  std::uint64_t file_size;
+  std::uint64_t checksum;
+
+  std::uint8_t reserved[32];
+};
+
+static_assert(sizeof(GraphFileHeader) == 128, "graph file header must stay 128 bytes");
+
+
+bool write_graph_file(const GraphCsr& csr, const std::string& path);
+bool write_graph_file(const Graph& graph, const std::string& path);
+
+
+// Read-only memory mapping of a graph file. Opening checks the header and
+// the section bounds only, so it takes O(1) regardless of the graph size.
+class MappedGraph
+{
+public:
+  enum class Check { Header, Full };
+
+  static std::optional<MappedGraph> open(const std::string& path, Check check = Check::Header);
+
+  MappedGraph(MappedGraph&& other) noexcept;
+  MappedGraph& operator= (MappedGraph&& other) noexcept;
+
+  MappedGraph(const MappedGraph&) = delete;
+  MappedGraph& operator= (const MappedGraph&) = delete;
+
+  ~MappedGraph();
+
+  size_t node_count() const;
+  size_t edge_count() const;
+
+  std::string_view label(size_t node) const;
+
+  GraphCsrView view() const;
+
+  // Recomputes the checksum and checks that every index is in range, O(n + m)
+  bool validate() const;
+
+  GraphCsr to_csr() const;
+
+private:
+  const std::uint8_t* data_;
+  size_t size_;
+
+  MappedGraph(const std::uint8_t* data, size_t size);
+
+  const GraphFileHeader& header() const;
+
+  template <class T>
+  const T* section(std::uint64_t pos) const;
+};
+
+
+// Checksum of the graph file sections (64 bit, word at a time)
+std::uint64_t graph_file_checksum(const std::uint8_t* data, size_t size);
+
+} // namespace Container
@@ -0,0 +1,601 @@
+#include "graph_hierarchy.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "graph_file.hpp"
+
+namespace Container {
+
+namespace {
+
+constexpr std::uint32_t no_middle = std::numeric_limits<std::uint32_t>::max();
+
+struct Edge
+{
+  std::uint32_t node;
+  std::uint64_t weight;
+  std::uint32_t middle;
+};
+
+using EdgeLists = std::vector<std::vector<Edge>>;
+
+
+// Remaining graph while nodes are contracted
+class Contractor
+{
+  // witness searches give up after this many nodes and keep the shortcut
+  static constexpr size_t witness_settle_limit = 500;
+
+  EdgeLists out_;
+  EdgeLists in_;
+  std::vector<std::uint32_t> deleted_neighbours_;
+
+  std::vector<std::uint64_t> witness_;
+  std::vector<std::uint32_t> touched_;
+  IndexedHeap<std::uint64_t> heap_;
+
+public:
+  explicit Contractor(const GraphCsrView& graph)
+    : out_(graph.node_count())
+    , in_(graph.node_count())
+    , deleted_neighbours_(graph.node_count(), 0)
+    , witness_(graph.node_count(), unreachable_distance)
+    , heap_(graph.node_count())
+  {
+    for (std::uint32_t u = 0; u < graph.node_count(); ++u)
+      for (auto e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e)
+        if (graph.targets[e] != u)
+          add_edge(u, graph.targets[e], graph.weights[e], no_middle);
+  }
+
+  // Contracts every node, rank[u] is its position in the order. up[u] gets
+  // the edges u -> v, down[u] the edges v -> u left when u went.
+  void run(std::vector<std::uint32_t>& rank, EdgeLists& up, EdgeLists& down)
+  {
+    const auto n = out_.size();
+
+    rank.assign(n, 0);
+    up.assign(n, {});
+    down.assign(n, {});
+
+    IndexedHeap<std::int64_t> queue(n);
+    for (std::uint32_t u = 0; u < n; ++u)
+      queue.push(u, priority(u));
+
+    std::uint32_t next = 0;
+
+    while (!queue.empty()) {
+      const auto u = static_cast<std::uint32_t>(queue.top());
+      queue.pop();
+
+      // lazy update: priorities only grow stale through contracted neighbours
+      const auto current = priority(u);
+      if (!queue.empty() && current > queue.top_value()) {
+        queue.push(u, current);
+        continue;
+      }
+
+      rank[u] = next++;
+      shortcuts(u, true);
+
+      up[u] = std::move(out_[u]);
+      down[u] = std::move(in_[u]);
+
+      for (const auto& e : up[u]) {
+        erase(in_[e.node], u);
+        ++deleted_neighbours_[e.node];
+      }
+
+      for (const auto& e : down[u]) {
+        erase(out_[e.node], u);
+        ++deleted_neighbours_[e.node];
+      }
+
+      out_[u].clear();
+      in_[u].clear();
+    }
+  }
+
+private:
+  static void erase(std::vector<Edge>& edges, std::uint32_t node)
+  {
+    edges.erase(std::remove_if(edges.begin(), edges.end(),
+      [node](const Edge& e) {
+        return e.node == node;
+      }), edges.end()
+    );
+  }
+
+  // keeps the lighter of parallel edges
+  void add_edge(std::uint32_t from, std::uint32_t to, std::uint64_t weight, std::uint32_t middle)
+  {
+    const auto by_node = [](std::uint32_t node) {
+      return [node](const Edge& e) { return e.node == node; };
+    };
+
+    const auto out = std::find_if(out_[from].begin(), out_[from].end(), by_node(to));
+
+    if (out == out_[from].end()) {
+      out_[from].push_back({to, weight, middle});
+      in_[to].push_back({from, weight, middle});
+      return;
+    }
+
+    if (weight < out->weight) {
+      *out = {to, weight, middle};
+      *std::find_if(in_[to].begin(), in_[to].end(), by_node(from)) = {from, weight, middle};
+    }
+  }
+
+  std::int64_t priority(std::uint32_t u)
+  {
+    const auto added = static_cast<std::int64_t>(shortcuts(u, false));
+    const auto removed = static_cast<std::int64_t>(in_[u].size() + out_[u].size());
+
+    return added - removed + deleted_neighbours_[u];
+  }
+
+  // Shortcuts needed to contract u, inserted when apply is set
+  size_t shortcuts(std::uint32_t u, bool apply)
+  {
+    size_t result = 0;
+
+    // in_[u] does not change below, only lists of other nodes do
+    for (const auto& in : in_[u]) {
+      // zero weight paths still need shortcuts, 0 is a valid limit
+      std::optional<std::uint64_t> limit;
+      for (const auto& out : out_[u])
+        if (out.node != in.node)
+          limit = std::max(limit.value_or(0), in.weight + out.weight);
+
+      if (!limit)
+        continue;
+
+      witness_search(in.node, u, *limit);
+
+      for (const auto& out : out_[u]) {
+        if (out.node == in.node || witness_[out.node] <= in.weight + out.weight)
+          continue;
+
+        ++result;
+
+        if (apply)
+          add_edge(in.node, out.node, in.weight + out.weight, u);
+      }
+    }
+
+    return result;
+  }
+
+  // Dijkstra from source avoiding skip, up to limit
+  void witness_search(std::uint32_t source, std::uint32_t skip, std::uint64_t limit)
+  {
+    for (const auto v : touched_)
+      witness_[v] = unreachable_distance;
+
+    touched_.clear();
+    heap_.clear();
+
+    witness_[source] = 0;
+    touched_.push_back(source);
+    heap_.push(source, 0);
+
+    for (size_t settled = 0; !heap_.empty() && settled < witness_settle_limit; ++settled) {
+      if (heap_.top_value() > limit)
+        break;
+
+      const auto x = static_cast<std::uint32_t>(heap_.top());
+      heap_.pop();
+
+      for (const auto& e : out_[x]) {
+        if (e.node == skip)
+          continue;
+
+        const auto candidate = witness_[x] + e.weight;
+
+        if (candidate < witness_[e.node]) {
+          if (witness_[e.node] == unreachable_distance)
+            touched_.push_back(e.node);
+
+          witness_[e.node] = candidate;
+          heap_.push_or_decrease(e.node, candidate);
+        }
+      }
+    }
+  }
+};
+
+
+// File layout: magic, version, counts, the arrays, checksum of the arrays
+constexpr char file_magic[8] = {'C', 'P', 'P', 'A', 'G', 'R', 'C', 'H'};
+constexpr std::uint32_t file_version = 1;
+
+template <class T>
+void put(std::vector<std::uint8_t>& out, const T* data, size_t count)
+{
+  const auto bytes = reinterpret_cast<const std::uint8_t*>(data);
+  out.insert(out.end(), bytes, bytes + count * sizeof(T));
+}
+
+template <class T>
+void put(std::vector<std::uint8_t>& out, const std::vector<T>& v) { put(out, v.data(), v.size()); }
+
+template <class T>
+void put(std::vector<std::uint8_t>& out, const T& value) { put(out, &value, 1); }
+
+
+class Reader
+{
+  const std::vector<std::uint8_t>& data_;
+  size_t pos_ = 0;
+
+public:
+  explicit Reader(const std::vector<std::uint8_t>& data) : data_(data) { }
+
+  size_t pos() const { return pos_; }
+
+  template <class T>
+  bool get(T* out, size_t count)
+  {
+    if (count > (data_.size() - pos_) / sizeof(T))
+      return false;
+
+    std::memcpy(out, data_.data() + pos_, count * sizeof(T));
+    pos_ += count * sizeof(T);
+    return true;
+  }
+
+  template <class T>
+  bool get(std::vector<T>& out, size_t count)
+  {
+    if (count > (data_.size() - pos_) / sizeof(T))
+      return false;
+
+    out.resize(count);
+    return get(out.data(), count);
+  }
+
+  template <class T>
+  bool get(T& out) { return get(&out, 1); }
+};
+
+} // namespace
+
+
+ContractionHierarchy::ContractionHierarchy(const GraphCsrView& graph)
+{
+  contract(graph);
+  prepare();
+}
+
+ContractionHierarchy::ContractionHierarchy(const Graph& graph)
+  : ContractionHierarchy(graph.csr().view())
+{ }
+
+
+void ContractionHierarchy::contract(const GraphCsrView& graph)
+{
+  EdgeLists up;
+  EdgeLists down;
+
+  Contractor(graph).run(rank_, up, down);
+
+  const auto flatten = [](const EdgeLists& lists, Arcs& arcs) {
+    for (const auto& edges : lists) {
+      for (const auto& e : edges) {
+        arcs.targets.push_back(e.node);
+        arcs.weights.push_back(e.weight);
+        arcs.middles.push_back(e.middle);
+      }
+
+      arcs.offsets.push_back(arcs.targets.size());
+    }
+  };
+
+  flatten(up, up_);
+  flatten(down, down_);
+}
+
+void ContractionHierarchy::prepare()
+{
+  ahead_.resize(rank_.size());
+  behind_.resize(rank_.size());
+}
+
+
+size_t ContractionHierarchy::node_count() const { return rank_.size(); }
+
+size_t ContractionHierarchy::shortcut_count() const
+{
+  const auto is_shortcut = [](std::uint32_t middle) { return middle != none; };
+
+  return std::count_if(up_.middles.begin(), up_.middles.end(), is_shortcut) +
+         std::count_if(down_.middles.begin(), down_.middles.end(), is_shortcut);
+}
+
+std::uint32_t ContractionHierarchy::rank(std::uint32_t u) const { return rank_[u]; }
+
+
+void ContractionHierarchy::Side::resize(size_t size)
+{
+  dist.assign(size, unreachable_distance);
+  parent.assign(size, none);
+  touched.clear();
+  heap = IndexedHeap<std::uint64_t>(size);
+}
+
+void ContractionHierarchy::Side::reset()
+{
+  for (const auto u : touched) {
+    dist[u] = unreachable_distance;
+    parent[u] = none;
+  }
+
+  touched.clear();
+  heap.clear();
+}
+
+
+Route ContractionHierarchy::query(std::uint32_t source, std::uint32_t target)
+{
+  Route route;
+
+  if (source >= node_count() || target >= node_count())
+    return route;
+
+  ahead_.reset();
+  behind_.reset();
+
+  ahead_.dist[source] = 0;
+  ahead_.touched.push_back(source);
+  ahead_.heap.push(source, 0);
+
+  behind_.dist[target] = 0;
+  behind_.touched.push_back(target);
+  behind_.heap.push(target, 0);
+
+  auto best = unreachable_distance;
+  auto meeting = none;
+
+  while (!ahead_.heap.empty() || !behind_.heap.empty()) {
+    const bool forward = behind_.heap.empty() ||
+      (!ahead_.heap.empty() && ahead_.heap.top_value() <= behind_.heap.top_value());
+
+    auto& side = forward ? ahead_ : behind_;
+    const auto& other = forward ? behind_ : ahead_;
+    const auto& arcs = forward ? up_ : down_;
+
+    // upward searches cannot stop at the first meeting, only once a side
+    // has nothing shorter than the best one left
+    if (side.heap.top_value() >= best) {
+      side.heap.clear();
+      continue;
+    }
+
+    const auto u = static_cast<std::uint32_t>(side.heap.top());
+    side.heap.pop();
+    ++route.settled;
+
+    if (other.dist[u] != unreachable_distance && side.dist[u] + other.dist[u] < best) {
+      best = side.dist[u] + other.dist[u];
+      meeting = u;
+    }
+
+    for (auto a = arcs.offsets[u]; a < arcs.offsets[u + 1]; ++a) {
+      const auto v = arcs.targets[a];
+      const auto candidate = side.dist[u] + arcs.weights[a];
+
+      if (candidate >= side.dist[v])
+        continue;
+
+      if (side.dist[v] == unreachable_distance)
+        side.touched.push_back(v);
+
+      side.dist[v] = candidate;
+      side.parent[v] = u;
+      side.heap.push_or_decrease(v, candidate);
+    }
+  }
+
+  if (meeting == none)
+    return route;
+
+  route.distance = best;
+
+  // hierarchy path: source ... meeting up, meeting ... target down
+  std::vector<std::uint32_t> nodes;
+  for (auto u = meeting; u != none; u = ahead_.parent[u])
+    nodes.push_back(u);
+
+  std::reverse(nodes.begin(), nodes.end());
+
+  for (auto u = behind_.parent[meeting]; u != none; u = behind_.parent[u])
+    nodes.push_back(u);
+
+  route.path.push_back(source);
+  for (size_t i = 0; i + 1 < nodes.size(); ++i)
+    unpack(nodes[i], nodes[i + 1], route.path);
+
+  return route;
+}
+
+
+auto ContractionHierarchy::find_arc(std::uint32_t from, std::uint32_t to) const
+  -> std::pair<const Arcs*, std::optional<size_t>>
+{
+  const bool upward = rank_[from] < rank_[to];
+  const auto& arcs = upward ? up_ : down_;
+  const auto at = upward ? from : to;
+  const auto other = upward ? to : from;
+
+  const auto first = arcs.targets.begin() + arcs.offsets[at];
+  const auto last = arcs.targets.begin() + arcs.offsets[at + 1];
+  const auto it = std::find(first, last, other);
+
+  if (it == last)
+    return {&arcs, std::nullopt};
+
+  return {&arcs, static_cast<size_t>(it - arcs.targets.begin())};
+}
+
+// contracted node between from and to, none for an original edge
+std::uint32_t ContractionHierarchy::middle(std::uint32_t from, std::uint32_t to) const
+{
+  const auto [arcs, a] = find_arc(from, to);
+  return arcs->middles[*a];
+}
+
+// appends the original path after from, up to to
+void ContractionHierarchy::unpack(std::uint32_t from, std::uint32_t to, std::vector<std::uint32_t>& path) const
+{
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> stack{{from, to}};
+
+  while (!stack.empty()) {
+    const auto [a, b] = stack.back();
+    stack.pop_back();
+
+    const auto m = middle(a, b);
+
+    if (m == none) {
+      path.push_back(b);
+      continue;
+    }
+
+    stack.push_back({m, b});
+    stack.push_back({a, m});
+  }
+}
+
+
+bool ContractionHierarchy::consistent() const
+{
+  const auto n = rank_.size();
+  std::vector<bool> seen(n, false);
+
+  for (const auto r : rank_) {
+    if (r >= n || seen[r])
+      return false;
+
+    seen[r] = true;
+  }
+
+  for (const auto* arcs : {&up_, &down_}) {
+    for (std::uint32_t u = 0; u < n; ++u) {
+      for (auto a = arcs->offsets[u]; a < arcs->offsets[u + 1]; ++a) {
+        const auto v = arcs->targets[a];
+        const auto m = arcs->middles[a];
+
+        if (rank_[v] <= rank_[u])
+          return false;
+
+        if (m == none)
+          continue;
+
+        // the shortcut runs u -> v upwards, v -> u downwards
+        const auto from = arcs == &up_ ? u : v;
+        const auto to = arcs == &up_ ? v : u;
+
+        if (rank_[m] >= rank_[u] || !find_arc(from, m).second || !find_arc(m, to).second)
+          return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+
+bool ContractionHierarchy::save(const std::string& path) const
+{
+  std::vector<std::uint8_t> body;
+
+  for (const auto* arcs : {&up_, &down_}) {
+    put(body, arcs->offsets);
+    put(body, arcs->targets);
+    put(body, arcs->weights);
+    put(body, arcs->middles);
+  }
+
+  put(body, rank_);
+
+  std::vector<std::uint8_t> header;
+  put(header, file_magic, sizeof(file_magic));
+  put(header, file_version);
+  put(header, std::uint32_t(0));
+  put(header, std::uint64_t(rank_.size()));
+  put(header, std::uint64_t(up_.size()));
+  put(header, std::uint64_t(down_.size()));
+  put(header, graph_file_checksum(body.data(), body.size()));
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+
+  out.write(reinterpret_cast<const char*>(header.data()), header.size());
+  out.write(reinterpret_cast<const char*>(body.data()), body.size());
+
+  return static_cast<bool>(out.flush());
+}
+
+std::optional<ContractionHierarchy> ContractionHierarchy::load(const std::string& path)
+{
+  std::ifstream in(path, std::ios::binary);
+
+  if (!in)
+    return std::nullopt;
+
+  const std::vector<std::uint8_t> data{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+  Reader reader(data);
+
+  char magic[8];
+  std::uint32_t version = 0;
+  std::uint32_t reserved = 0;
+  std::uint64_t nodes = 0;
+  std::uint64_t up_count = 0;
+  std::uint64_t down_count = 0;
+  std::uint64_t checksum = 0;
+
+  if (!reader.get(magic, 8) || std::memcmp(magic, file_magic, 8) != 0 ||
+      !reader.get(version) || version != file_version ||
+      !reader.get(reserved) || !reader.get(nodes) || !reader.get(up_count) ||
+      !reader.get(down_count) || !reader.get(checksum))
+    return std::nullopt;
+
+  if (nodes >= none)
+    return std::nullopt;
+
+  const auto body = reader.pos();
+
+  if (graph_file_checksum(data.data() + body, data.size() - body) != checksum)
+    return std::nullopt;
+
+  ContractionHierarchy result;
+
+  const auto read_arcs = [&](Arcs& arcs, std::uint64_t count) {
+    if (!reader.get(arcs.offsets, nodes + 1) || !reader.get(arcs.targets, count) ||
+        !reader.get(arcs.weights, count) || !reader.get(arcs.middles, count))
+      return false;
+
+    if (arcs.offsets.front() != 0 || arcs.offsets.back() != count ||
+        !std::is_sorted(arcs.offsets.begin(), arcs.offsets.end()))
+      return false;
+
+    return std::all_of(arcs.targets.begin(), arcs.targets.end(), [nodes](std::uint32_t v) { return v < nodes; }) &&
+           std::all_of(arcs.middles.begin(), arcs.middles.end(),
+                       [nodes](std::uint32_t m) { return m == none || m < nodes; });
+  };
+
+  if (!read_arcs(result.up_, up_count) || !read_arcs(result.down_, down_count) ||
+      !reader.get(result.rank_, nodes) || reader.pos() != data.size())
+    return std::nullopt;
+
+  // a well-formed file may still not be a hierarchy the queries can walk
+  if (!result.consistent())
+    return std::nullopt;
+
+  result.prepare();
+  return result;
+}
+
+} // namespace Container
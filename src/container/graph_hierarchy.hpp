@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef> // size_t
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "graph.hpp"
+#include "graph_csr.hpp"
+#include "graph_search.hpp"
+#include "indexed_heap.hpp"
+
+namespace Container {
+
+/*
+  Contraction hierarchy for point to point queries on a static graph.
+
+  Nodes are contracted one by one, the next one is the one with the
+  smallest edge difference (shortcuts added minus edges removed, plus the
+  contracted neighbours to spread the order). A shortcut u -> w replaces
+  u -> v -> w unless a bounded witness search finds a path that is not
+  longer. A query is a bidirectional Dijkstra that only goes up in rank,
+  shortcuts are unpacked back into original edges for the path.
+
+  Preprocessing takes a while on big graphs, save() and load() keep the
+  result in a binary file.
+*/
+class ContractionHierarchy
+{
+public:
+  explicit ContractionHierarchy(const GraphCsrView& graph);
+  explicit ContractionHierarchy(const Graph& graph);
+
+  static std::optional<ContractionHierarchy> load(const std::string& path);
+  bool save(const std::string& path) const;
+
+  size_t node_count() const;
+  size_t shortcut_count() const;
+
+  // position of u in the contraction order
+  std::uint32_t rank(std::uint32_t u) const;
+
+  Route query(std::uint32_t source, std::uint32_t target);
+
+private:
+  static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+  // edges to higher ranked nodes in compressed sparse row form,
+  // middle is the contracted node of a shortcut, none for an original edge
+  struct Arcs
+  {
+    std::vector<std::uint64_t> offsets{0};
+    std::vector<std::uint32_t> targets;
+    std::vector<std::uint64_t> weights;
+    std::vector<std::uint32_t> middles;
+
+    size_t size() const { return targets.size(); }
+  };
+
+  struct Side
+  {
+    std::vector<std::uint64_t> dist;
+    std::vector<std::uint32_t> parent;
+    std::vector<std::uint32_t> touched;
+    IndexedHeap<std::uint64_t> heap;
+
+    void resize(size_t size);
+    void reset();
+  };
+
+  std::vector<std::uint32_t> rank_;
+  Arcs up_;   // at u: u -> v with rank v > rank u
+  Arcs down_; // at u: v -> u with rank v > rank u
+
+  Side ahead_;
+  Side behind_;
+
+  ContractionHierarchy() = default;
+
+  void contract(const GraphCsrView& graph);
+  void prepare();
+
+  // rank_ is a permutation, arcs lead to higher ranks, shortcuts to lower
+  // middles whose two halves are stored
+  bool consistent() const;
+
+  // arcs that hold from -> to by rank, and its position there if stored
+  std::pair<const Arcs*, std::optional<size_t>> find_arc(std::uint32_t from, std::uint32_t to) const;
+
+  std::uint32_t middle(std::uint32_t from, std::uint32_t to) const;
+  void unpack(std::uint32_t from, std::uint32_t to, std::vector<std::uint32_t>& path) const;
+};
+
+} // namespace Container
@@ -0,0 +1,355 @@
+#include "graph_import.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "parallel.hpp"
+
+namespace Container {
+
+namespace {
+
+class MappedFile
+{
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+
+public:
+  MappedFile() = default;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator= (const MappedFile&) = delete;
+
+  ~MappedFile()
+  {
+    if (data_)
+      ::munmap(const_cast<char*>(data_), size_);
+  }
+
+  bool open(const std::string& path)
+  {
+    const auto fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+      return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      return false;
+    }
+
+    size_ = static_cast<size_t>(st.st_size);
+
+    if (size_ != 0) {
+      const auto address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+
+      if (address == MAP_FAILED) {
+        ::close(fd);
+        size_ = 0;
+        return false;
+      }
+
+      data_ = static_cast<const char*>(address);
+      ::madvise(address, size_, MADV_SEQUENTIAL);
+    }
+
+    ::close(fd);
+    return true;
+  }
+
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+};
+
+
+// Sharded label -> id table. Ids are handed out in arrival order, the
+// position of the first appearance is kept to renumber them afterwards.
+class LabelTable
+{
+  struct Entry
+  {
+    std::uint32_t id;
+    std::uint64_t first;
+  };
+
+  struct Shard
+  {
+    std::mutex mutex;
+    std::unordered_map<std::string_view, Entry> labels;
+  };
+
+  static constexpr size_t shard_count = 64;
+
+  std::array<Shard, shard_count> shards_;
+  std::atomic<std::uint32_t> next_{0};
+
+public:
+  std::uint32_t intern(std::string_view label, std::uint64_t pos)
+  {
+    const auto hash = std::hash<std::string_view>{}(label);
+    auto& shard = shards_[(hash >> 32) % shard_count];
+
+    std::lock_guard lock(shard.mutex);
+
+    const auto [it, inserted] = shard.labels.try_emplace(label, Entry{0, pos});
+
+    if (inserted)
+      it->second.id = next_++;
+    else
+      it->second.first = std::min(it->second.first, pos);
+
+    return it->second.id;
+  }
+
+  size_t size() const { return next_; }
+
+  // renumber[id] is the rank of the label by first appearance
+  void order(std::vector<std::uint32_t>& renumber, std::vector<std::string>& labels) const
+  {
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> first(size());
+    std::vector<std::string_view> names(size());
+
+    for (const auto& shard : shards_) {
+      for (const auto& [label, entry] : shard.labels) {
+        first[entry.id] = {entry.first, entry.id};
+        names[entry.id] = label;
+      }
+    }
+
+    std::sort(first.begin(), first.end());
+
+    renumber.assign(size(), 0);
+    labels.clear();
+    labels.reserve(size());
+
+    for (size_t rank = 0; rank < first.size(); ++rank) {
+      renumber[first[rank].second] = static_cast<std::uint32_t>(rank);
+      labels.emplace_back(names[first[rank].second]);
+    }
+  }
+};
+
+
+struct Edge
+{
+  std::uint32_t from;
+  std::uint32_t to;
+  std::uint32_t coast;
+};
+
+struct Chunk
+{
+  const char* first;
+  const char* last;
+  std::vector<Edge> edges;
+  bool ok = true;
+};
+
+
+bool is_blank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+void skip_blanks(const char*& p, const char* last)
+{
+  while (p != last && is_blank(*p))
+    ++p;
+}
+
+std::string_view read_token(const char*& p, const char* last)
+{
+  const auto first = p;
+
+  while (p != last && !is_blank(*p) && *p != '\n')
+    ++p;
+
+  return {first, static_cast<size_t>(p - first)};
+}
+
+// Plain decimal, no locale, no sign
+bool read_number(const char*& p, const char* last, std::uint32_t& value)
+{
+  std::uint64_t result = 0;
+  const auto first = p;
+
+  while (p != last && *p >= '0' && *p <= '9') {
+    result = result * 10 + static_cast<std::uint64_t>(*p - '0');
+
+    if (result > std::numeric_limits<std::uint32_t>::max())
+      return false;
+
+    ++p;
+  }
+
+  value = static_cast<std::uint32_t>(result);
+  return p != first;
+}
+
+
+void parse(Chunk& chunk, const char* base, LabelTable& table)
+{
+  // labels already interned by this thread, saves the shard locks
+  std::unordered_map<std::string_view, std::uint32_t> local;
+
+  const auto intern = [&](std::string_view label, const char* at) {
+    const auto it = local.find(label);
+
+    if (it != local.end())
+      return it->second;
+
+    const auto id = table.intern(label, static_cast<std::uint64_t>(at - base));
+    local.emplace(label, id);
+    return id;
+  };
+
+  const auto last = chunk.last;
+  auto p = chunk.first;
+
+  while (p != last) {
+    skip_blanks(p, last);
+
+    if (p == last)
+      break;
+
+    if (*p == '\n') {
+      ++p;
+      continue;
+    }
+
+    if (*p == '#' || *p == '%') {
+      p = std::find(p, last, '\n');
+      continue;
+    }
+
+    const auto from_at = p;
+    const auto from = read_token(p, last);
+    skip_blanks(p, last);
+
+    const auto to_at = p;
+    const auto to = read_token(p, last);
+    skip_blanks(p, last);
+
+    std::uint32_t coast;
+
+    if (to.empty() || !read_number(p, last, coast)) {
+      chunk.ok = false;
+      return;
+    }
+
+    skip_blanks(p, last);
+
+    if (p != last && *p != '\n') {
+      chunk.ok = false;
+      return;
+    }
+
+    chunk.edges.push_back({intern(from, from_at), intern(to, to_at), coast});
+  }
+}
+
+} // namespace
+
+
+std::optional<GraphCsr> import_edge_list(const std::string& path, size_t threads)
+{
+  MappedFile file;
+
+  if (!file.open(path))
+    return std::nullopt;
+
+  const auto data = file.data();
+  const auto size = file.size();
+
+  threads = std::max<size_t>(1, std::min(threads, size / 4096 + 1));
+
+  // cut the file at line starts
+  std::vector<Chunk> chunks(threads);
+  size_t begin = 0;
+
+  for (size_t i = 0; i < threads; ++i) {
+    auto end = i + 1 == threads ? size : std::max(begin, size / threads * (i + 1));
+
+    while (end < size && data[end - 1] != '\n')
+      ++end;
+
+    chunks[i].first = data + begin;
+    chunks[i].last = data + end;
+    begin = end;
+  }
+
+  LabelTable table;
+
+  Utility::for_each_index(threads, [&](size_t i) { parse(chunks[i], data, table); });
+
+  for (const auto& chunk : chunks)
+    if (!chunk.ok)
+      return std::nullopt;
+
+  GraphCsr result;
+
+  std::vector<std::uint32_t> renumber;
+  table.order(renumber, result.labels);
+
+  const auto n = result.labels.size();
+
+  // pass 1: degrees
+  std::vector<std::atomic<std::uint64_t>> cursor(n);
+
+  Utility::for_each_index(threads, [&](size_t i) {
+    for (const auto& edge : chunks[i].edges)
+      cursor[renumber[edge.from]].fetch_add(1, std::memory_order_relaxed);
+  });
+
+  result.offsets.assign(n + 1, 0);
+
+  for (size_t u = 0; u < n; ++u) {
+    const auto degree = cursor[u].load(std::memory_order_relaxed);
+    result.offsets[u + 1] = result.offsets[u] + degree;
+    cursor[u].store(result.offsets[u], std::memory_order_relaxed);
+  }
+
+  const auto m = result.offsets[n];
+
+  // pass 2: fill
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> adjacency(m);
+
+  Utility::for_each_index(threads, [&](size_t i) {
+    for (const auto& edge : chunks[i].edges) {
+      const auto pos = cursor[renumber[edge.from]].fetch_add(1, std::memory_order_relaxed);
+      adjacency[pos] = {renumber[edge.to], edge.coast};
+    }
+  });
+
+  // threads fill the lists in any order, sorting makes the result stable
+  result.targets.resize(m);
+  result.weights.resize(m);
+
+  Utility::for_each_index(threads, [&](size_t i) {
+    for (size_t u = i; u < n; u += threads) {
+      const auto first = adjacency.begin() + result.offsets[u];
+      const auto last = adjacency.begin() + result.offsets[u + 1];
+
+      std::sort(first, last);
+
+      for (auto e = result.offsets[u]; e < result.offsets[u + 1]; ++e) {
+        result.targets[e] = adjacency[e].first;
+        result.weights[e] = adjacency[e].second;
+      }
+    }
+  });
+
+  return result;
+}
+
+} // namespace Container
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef> // size_t
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "graph_csr.hpp"
+
+namespace Container {
+
+/*
+  Imports a text edge list, one "from to cost" edge per line. Labels are
+  any non-blank tokens, cost is an unsigned 32 bit integer. Blank lines and
+  lines starting with '#' or '%' are skipped.
+
+  The file is memory mapped and parsed in threads chunks, as tasks on the
+  shared thread pool. Vertex ids follow the first appearance of the label
+  in the file, adjacency lists are sorted by target. Returns nullopt when
+  the file can't be read or a line is malformed.
+*/
+std::optional<GraphCsr> import_edge_list(const std::string& path,
+                                         size_t threads = std::thread::hardware_concurrency());
+
+} // namespace Container
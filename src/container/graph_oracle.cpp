@@ -0,0 +1,298 @@
+#include "graph_oracle.hpp"
+
+#include <algorithm>
+
+namespace Container {
+
+DistanceOracle::DistanceOracle(Graph& graph)
+  : graph_(graph)
+{
+  const auto csr = graph.csr();
+  const auto n = csr.node_count();
+
+  out_.resize(n);
+  in_.resize(n);
+
+  heap_.reserve(n);
+  affected_.assign(n, false);
+
+  for (size_t u = 0; u < n; ++u) {
+    ids_.try_emplace(csr.labels[u], static_cast<std::uint32_t>(u));
+
+    for (auto e = csr.offsets[u]; e < csr.offsets[u + 1]; ++e) {
+      out_[u].push_back({csr.targets[e], csr.weights[e]});
+      in_[csr.targets[e]].push_back({static_cast<std::uint32_t>(u), csr.weights[e]});
+    }
+  }
+}
+
+
+void DistanceOracle::track(const std::string& source)
+{
+  const auto s = id(source);
+
+  if (!s || tree(*s))
+    return;
+
+  Tree t{*s, {}, {}};
+  build(t);
+  trees_.push_back(std::move(t));
+}
+
+void DistanceOracle::track_all()
+{
+  for (const auto& [label, u] : ids_)
+    track(label);
+}
+
+
+std::optional<size_t> DistanceOracle::distance(const std::string& from, const std::string& to) const
+{
+  const auto s = id(from);
+  const auto t = id(to);
+
+  if (!s || !t)
+    return std::nullopt;
+
+  const auto found = tree(*s);
+
+  if (!found)
+    return std::nullopt;
+
+  return found->dist[*t];
+}
+
+std::optional<size_t> DistanceOracle::eccentricity(const std::string& source) const
+{
+  const auto s = id(source);
+  const auto found = s ? tree(*s) : nullptr;
+
+  if (!found)
+    return std::nullopt;
+
+  return *std::max_element(found->dist.begin(), found->dist.end());
+}
+
+size_t DistanceOracle::radius() const
+{
+  auto result = unreachable;
+
+  for (const auto& t : trees_)
+    result = std::min(result, *std::max_element(t.dist.begin(), t.dist.end()));
+
+  return result;
+}
+
+
+void DistanceOracle::add_node(const std::string& label)
+{
+  graph_.add_node(label);
+
+  const auto u = static_cast<std::uint32_t>(out_.size());
+
+  ids_.try_emplace(label, u);
+  out_.emplace_back();
+  in_.emplace_back();
+
+  heap_.reserve(out_.size());
+  affected_.push_back(false);
+
+  for (auto& t : trees_) {
+    t.dist.push_back(unreachable);
+    t.parent.push_back(none);
+  }
+}
+
+void DistanceOracle::add_adj(const std::string& from, const std::string& to, size_t coast)
+{
+  const auto u = id(from);
+  const auto v = id(to);
+
+  if (!u || !v)
+    return;
+
+  graph_.add_adj(from, to, coast);
+
+  out_[*u].push_back({*v, coast});
+  in_[*v].push_back({*u, coast});
+
+  for (auto& t : trees_)
+    decrease(t, *u, *v, coast);
+}
+
+void DistanceOracle::edit_adj(const std::string& from, const std::string& to, size_t new_coast)
+{
+  const auto u = id(from);
+  const auto v = id(to);
+
+  if (!u || !v)
+    return;
+
+  const auto by_node = [](std::uint32_t node) {
+    return [node](const Arc& arc) { return arc.node == node; };
+  };
+
+  const auto out = std::find_if(out_[*u].begin(), out_[*u].end(), by_node(*v));
+
+  if (out == out_[*u].end())
+    return;
+
+  graph_.edit_adj(from, to, new_coast);
+
+  const auto old_coast = out->coast;
+  out->coast = new_coast;
+  std::find_if(in_[*v].begin(), in_[*v].end(), by_node(*u))->coast = new_coast;
+
+  for (auto& t : trees_) {
+    if (new_coast < old_coast)
+      decrease(t, *u, *v, new_coast);
+    else if (old_coast < new_coast)
+      increase(t, *u, *v, old_coast);
+  }
+}
+
+void DistanceOracle::del_adj(const std::string& from, const std::string& to)
+{
+  const auto u = id(from);
+  const auto v = id(to);
+
+  if (!u || !v)
+    return;
+
+  const auto by_node = [](std::uint32_t node) {
+    return [node](const Arc& arc) { return arc.node == node; };
+  };
+
+  const auto out = std::find_if(out_[*u].begin(), out_[*u].end(), by_node(*v));
+
+  if (out == out_[*u].end())
+    return;
+
+  graph_.del_adj(from, to);
+
+  const auto old_coast = out->coast;
+  out_[*u].erase(out);
+  in_[*v].erase(std::find_if(in_[*v].begin(), in_[*v].end(), by_node(*u)));
+
+  for (auto& t : trees_)
+    increase(t, *u, *v, old_coast);
+}
+
+
+std::optional<std::uint32_t> DistanceOracle::id(const std::string& label) const
+{
+  const auto it = ids_.find(label);
+
+  if (it == ids_.end())
+    return std::nullopt;
+
+  return it->second;
+}
+
+auto DistanceOracle::tree(std::uint32_t source) const -> const Tree*
+{
+  const auto it = std::find_if(trees_.begin(), trees_.end(),
+    [source](const Tree& t) {
+      return t.source == source;
+    }
+  );
+
+  return it == trees_.end() ? nullptr : &*it;
+}
+
+
+void DistanceOracle::build(Tree& tree)
+{
+  tree.dist.assign(out_.size(), unreachable);
+  tree.parent.assign(out_.size(), none);
+
+  tree.dist[tree.source] = 0;
+  heap_.push(tree.source, 0);
+
+  settle(tree);
+}
+
+
+void DistanceOracle::decrease(Tree& tree, std::uint32_t u, std::uint32_t v, size_t coast)
+{
+  if (tree.dist[u] == unreachable || tree.dist[u] + coast >= tree.dist[v])
+    return;
+
+  tree.dist[v] = tree.dist[u] + coast;
+  tree.parent[v] = u;
+
+  heap_.push(v, tree.dist[v]);
+
+  settle(tree);
+}
+
+void DistanceOracle::increase(Tree& tree, std::uint32_t u, std::uint32_t v, size_t old_coast)
+{
+  // only a tree edge carries distances
+  if (tree.parent[v] != u || tree.dist[u] == unreachable || tree.dist[u] + old_coast != tree.dist[v])
+    return;
+
+  // nodes whose shortest path ran through u -> v
+  std::vector<std::uint32_t> affected{v};
+  affected_[v] = true;
+
+  for (size_t i = 0; i < affected.size(); ++i) {
+    const auto x = affected[i];
+
+    for (const auto& arc : out_[x]) {
+      if (tree.parent[arc.node] == x && !affected_[arc.node]) {
+        affected_[arc.node] = true;
+        affected.push_back(arc.node);
+      }
+    }
+  }
+
+  for (const auto x : affected) {
+    tree.dist[x] = unreachable;
+    tree.parent[x] = none;
+  }
+
+  // best entry into the affected region from the rest of the tree
+  for (const auto x : affected) {
+    for (const auto& arc : in_[x]) {
+      if (affected_[arc.node] || tree.dist[arc.node] == unreachable)
+        continue;
+
+      const auto candidate = tree.dist[arc.node] + arc.coast;
+
+      if (candidate < tree.dist[x]) {
+        tree.dist[x] = candidate;
+        tree.parent[x] = arc.node;
+      }
+    }
+
+    if (tree.dist[x] != unreachable)
+      heap_.push(x, tree.dist[x]);
+  }
+
+  for (const auto x : affected)
+    affected_[x] = false;
+
+  settle(tree);
+}
+
+
+void DistanceOracle::settle(Tree& tree)
+{
+  while (!heap_.empty()) {
+    const auto x = static_cast<std::uint32_t>(heap_.top());
+    heap_.pop();
+
+    for (const auto& arc : out_[x]) {
+      const auto candidate = tree.dist[x] + arc.coast;
+
+      if (candidate < tree.dist[arc.node]) {
+        tree.dist[arc.node] = candidate;
+        tree.parent[arc.node] = x;
+        heap_.push_or_decrease(arc.node, candidate);
+      }
+    }
+  }
+}
+
+} // namespace Container
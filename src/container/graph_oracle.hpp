@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef> // size_t
+#include <limits>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "graph.hpp"
+#include "indexed_heap.hpp"
+
+namespace Container {
+
+/*
+  Keeps shortest path trees of the tracked sources up to date while the
+  graph changes. Edits go through the oracle, which applies them to the
+  graph as well.
+
+  Adding an edge or lowering its coast repairs the trees locally, the way
+  Ramalingam-Reps does: only nodes whose distance drops are visited.
+  Raising a coast or deleting a tree edge recomputes the subtree that hung
+  from it, other nodes keep their distances.
+*/
+class DistanceOracle
+{
+public:
+  static constexpr size_t unreachable = std::numeric_limits<size_t>::max();
+
+  explicit DistanceOracle(Graph& graph);
+
+  void track(const std::string& source);
+  void track_all();
+
+  // nullopt when from is not tracked or a label is unknown
+  std::optional<size_t> distance(const std::string& from, const std::string& to) const;
+
+  // Largest distance from source, nullopt when it is not tracked
+  std::optional<size_t> eccentricity(const std::string& source) const;
+
+  // Smallest eccentricity of the tracked sources,
+  // the same as Graph::radius() once every node is tracked
+  size_t radius() const;
+
+  void add_node(const std::string& label);
+  void add_adj(const std::string& from, const std::string& to, size_t coast);
+  void edit_adj(const std::string& from, const std::string& to, size_t new_coast);
+  void del_adj(const std::string& from, const std::string& to);
+
+private:
+  static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+  struct Arc
+  {
+    std::uint32_t node;
+    size_t coast;
+  };
+
+  struct Tree
+  {
+    std::uint32_t source;
+    std::vector<size_t> dist;
+    std::vector<std::uint32_t> parent;
+  };
+
+  Graph& graph_;
+
+  std::unordered_map<std::string, std::uint32_t> ids_;
+  std::vector<std::vector<Arc>> out_;
+  std::vector<std::vector<Arc>> in_;
+
+  std::vector<Tree> trees_;
+
+  // scratch of the repairs, sized to the graph once
+  IndexedHeap<size_t> heap_;
+  std::vector<bool> affected_;
+
+  std::optional<std::uint32_t> id(const std::string& label) const;
+  const Tree* tree(std::uint32_t source) const;
+
+  void build(Tree& tree);
+
+  // u -> v became cheaper (or appeared) with the given coast
+  void decrease(Tree& tree, std::uint32_t u, std::uint32_t v, size_t coast);
+
+  // u -> v with the given coast became more expensive (or disappeared)
+  void increase(Tree& tree, std::uint32_t u, std::uint32_t v, size_t old_coast);
+
+  // Dijkstra from the nodes in heap_, touches only nodes that improve
+  void settle(Tree& tree);
+};
+
+} // namespace Container
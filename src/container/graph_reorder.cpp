@@ -0,0 +1,354 @@
+#include "graph_reorder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <queue>
+
+namespace Container {
+
+namespace {
+
+// both directions of every edge, self loops dropped
+struct Adjacency
+{
+  std::vector<std::uint64_t> offsets;
+  std::vector<std::uint32_t> targets;
+
+  size_t node_count() const { return offsets.size() - 1; }
+  size_t degree(size_t u) const { return offsets[u + 1] - offsets[u]; }
+};
+
+Adjacency undirected(const GraphCsrView& graph)
+{
+  const auto n = graph.node_count();
+
+  Adjacency adj;
+  adj.offsets.assign(n + 1, 0);
+
+  for (size_t u = 0; u < n; ++u) {
+    for (auto e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+      if (graph.targets[e] != u) {
+        ++adj.offsets[u + 1];
+        ++adj.offsets[graph.targets[e] + 1];
+      }
+    }
+  }
+
+  std::partial_sum(adj.offsets.begin(), adj.offsets.end(), adj.offsets.begin());
+  adj.targets.resize(adj.offsets.back());
+
+  std::vector<std::uint64_t> fill(adj.offsets.begin(), adj.offsets.end() - 1);
+
+  for (size_t u = 0; u < n; ++u) {
+    for (auto e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+      const auto v = graph.targets[e];
+
+      if (v != u) {
+        adj.targets[fill[u]++] = v;
+        adj.targets[fill[v]++] = static_cast<std::uint32_t>(u);
+      }
+    }
+  }
+
+  return adj;
+}
+
+
+// order[new id] == old id  ->  permutation[old id] == new id
+std::vector<std::uint32_t> invert(const std::vector<std::uint32_t>& order)
+{
+  std::vector<std::uint32_t> result(order.size());
+
+  for (size_t i = 0; i < order.size(); ++i)
+    result[order[i]] = static_cast<std::uint32_t>(i);
+
+  return result;
+}
+
+
+// breadth first from every unvisited root in turn, the order doubles as the queue
+std::vector<std::uint32_t> breadth_first(const Adjacency& adj, const std::vector<std::uint32_t>& roots,
+                                         bool by_degree)
+{
+  std::vector<std::uint32_t> order;
+  order.reserve(adj.node_count());
+
+  std::vector<bool> visited(adj.node_count(), false);
+
+  const auto less_degree = [&adj](std::uint32_t a, std::uint32_t b) {
+    return adj.degree(a) < adj.degree(b);
+  };
+
+  for (const auto root : roots) {
+    if (visited[root])
+      continue;
+
+    visited[root] = true;
+    order.push_back(root);
+
+    for (auto head = order.size() - 1; head < order.size(); ++head) {
+      const auto u = order[head];
+      const auto first = order.size();
+
+      for (auto e = adj.offsets[u]; e < adj.offsets[u + 1]; ++e) {
+        const auto v = adj.targets[e];
+
+        if (!visited[v]) {
+          visited[v] = true;
+          order.push_back(v);
+        }
+      }
+
+      if (by_degree)
+        std::stable_sort(order.begin() + first, order.end(), less_degree);
+    }
+  }
+
+  return order;
+}
+
+std::vector<std::uint32_t> identity(size_t size)
+{
+  std::vector<std::uint32_t> result(size);
+  std::iota(result.begin(), result.end(), 0);
+  return result;
+}
+
+} // namespace
+
+
+std::vector<std::uint32_t> bfs_permutation(const GraphCsrView& graph)
+{
+  const auto adj = undirected(graph);
+  return invert(breadth_first(adj, identity(adj.node_count()), false));
+}
+
+std::vector<std::uint32_t> rcm_permutation(const GraphCsrView& graph)
+{
+  const auto adj = undirected(graph);
+
+  auto roots = identity(adj.node_count());
+  std::stable_sort(roots.begin(), roots.end(),
+    [&adj](std::uint32_t a, std::uint32_t b) {
+      return adj.degree(a) < adj.degree(b);
+    }
+  );
+
+  auto order = breadth_first(adj, roots, true);
+  std::reverse(order.begin(), order.end());
+
+  return invert(order);
+}
+
+std::vector<std::uint32_t> degree_permutation(const GraphCsrView& graph)
+{
+  const auto adj = undirected(graph);
+
+  auto order = identity(adj.node_count());
+  std::stable_sort(order.begin(), order.end(),
+    [&adj](std::uint32_t a, std::uint32_t b) {
+      return adj.degree(a) > adj.degree(b);
+    }
+  );
+
+  return invert(order);
+}
+
+
+std::vector<std::uint32_t> gorder_permutation(const GraphCsrView& graph, size_t window, size_t hub_degree)
+{
+  const auto adj = undirected(graph);
+  const auto n = adj.node_count();
+
+  // fallback when nothing in the window relates to the rest, hubs first
+  auto by_degree = identity(n);
+  std::stable_sort(by_degree.begin(), by_degree.end(),
+    [&adj](std::uint32_t a, std::uint32_t b) {
+      return adj.degree(a) > adj.degree(b);
+    }
+  );
+
+  std::vector<std::uint32_t> order;
+  order.reserve(n);
+
+  std::vector<bool> placed(n, false);
+  std::vector<std::uint32_t> score(n, 0);
+
+  // lazy max-heap, an entry is live while it matches score
+  std::priority_queue<std::pair<std::uint32_t, std::uint32_t>> candidates;
+
+  const auto add = [&](std::uint32_t x, bool enter) {
+    if (placed[x])
+      return;
+
+    score[x] = enter ? score[x] + 1 : score[x] - 1;
+
+    if (score[x] > 0)
+      candidates.push({score[x], x});
+  };
+
+  // v enters or leaves the window
+  const auto update = [&](std::uint32_t v, bool enter) {
+    for (auto e = adj.offsets[v]; e < adj.offsets[v + 1]; ++e) {
+      const auto u = adj.targets[e];
+      add(u, enter);
+
+      if (adj.degree(u) > hub_degree)
+        continue;
+
+      for (auto s = adj.offsets[u]; s < adj.offsets[u + 1]; ++s)
+        if (adj.targets[s] != v)
+          add(adj.targets[s], enter);
+    }
+  };
+
+  size_t next = 0;
+
+  while (order.size() < n) {
+    std::uint32_t v = 0;
+    bool found = false;
+
+    while (!candidates.empty()) {
+      const auto [s, x] = candidates.top();
+      candidates.pop();
+
+      if (!placed[x] && s == score[x]) {
+        v = x;
+        found = true;
+        break;
+      }
+    }
+
+    if (!found) {
+      while (placed[by_degree[next]])
+        ++next;
+
+      v = by_degree[next];
+    }
+
+    placed[v] = true;
+    order.push_back(v);
+
+    update(v, true);
+
+    if (order.size() > window)
+      update(order[order.size() - window - 1], false);
+  }
+
+  return invert(order);
+}
+
+
+GraphCsr relabel(const GraphCsr& graph, const std::vector<std::uint32_t>& permutation)
+{
+  const auto n = graph.node_count();
+
+  std::vector<std::uint32_t> order(n);
+  for (size_t u = 0; u < n; ++u)
+    order[permutation[u]] = static_cast<std::uint32_t>(u);
+
+  GraphCsr result;
+  result.offsets.reserve(n + 1);
+  result.targets.reserve(graph.edge_count());
+  result.weights.reserve(graph.edge_count());
+  result.labels.reserve(n);
+
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+
+  for (const auto old : order) {
+    result.labels.push_back(graph.labels[old]);
+
+    edges.clear();
+    for (auto e = graph.offsets[old]; e < graph.offsets[old + 1]; ++e)
+      edges.push_back({permutation[graph.targets[e]], graph.weights[e]});
+
+    std::sort(edges.begin(), edges.end());
+
+    for (const auto& [target, weight] : edges) {
+      result.targets.push_back(target);
+      result.weights.push_back(weight);
+    }
+
+    result.offsets.push_back(result.targets.size());
+  }
+
+  return result;
+}
+
+
+std::vector<std::uint32_t> partition(const GraphCsrView& graph, std::uint32_t parts,
+                                     size_t iterations, double imbalance)
+{
+  const auto adj = undirected(graph);
+  const auto n = adj.node_count();
+
+  parts = std::max<std::uint32_t>(parts, 1);
+
+  std::vector<std::uint32_t> result(n);
+  std::vector<size_t> sizes(parts, 0);
+
+  // contiguous BFS blocks are connected-ish and balanced
+  const auto order = breadth_first(adj, identity(n), false);
+
+  for (size_t i = 0; i < n; ++i) {
+    result[order[i]] = static_cast<std::uint32_t>(i * parts / n);
+    ++sizes[result[order[i]]];
+  }
+
+  const auto even = (n + parts - 1) / parts;
+  const auto capacity = std::max(even, static_cast<size_t>(std::ceil((1.0 + imbalance) * n / parts)));
+
+  std::vector<std::uint32_t> counts(parts, 0);
+  std::vector<std::uint32_t> touched;
+
+  for (size_t iteration = 0; iteration < iterations; ++iteration) {
+    size_t moved = 0;
+
+    for (const auto u : order) {
+      touched.clear();
+
+      for (auto e = adj.offsets[u]; e < adj.offsets[u + 1]; ++e) {
+        const auto p = result[adj.targets[e]];
+
+        if (counts[p]++ == 0)
+          touched.push_back(p);
+      }
+
+      const auto current = result[u];
+      auto best = current;
+
+      for (const auto p : touched)
+        if (counts[p] > counts[best] && sizes[p] < capacity)
+          best = p;
+
+      for (const auto p : touched)
+        counts[p] = 0;
+
+      if (best != current) {
+        --sizes[current];
+        ++sizes[best];
+        result[u] = best;
+        ++moved;
+      }
+    }
+
+    if (moved == 0)
+      break;
+  }
+
+  return result;
+}
+
+size_t cut_edges(const GraphCsrView& graph, const std::vector<std::uint32_t>& parts)
+{
+  size_t result = 0;
+
+  for (size_t u = 0; u < graph.node_count(); ++u)
+    for (auto e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e)
+      result += parts[u] != parts[graph.targets[e]];
+
+  return result;
+}
+
+} // namespace Container
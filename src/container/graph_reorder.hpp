@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef> // size_t
+#include <vector>
+
+#include "graph_csr.hpp"
+
+namespace Container {
+
+/*
+  Vertex reordering for locality. Every pass returns a permutation with
+  permutation[old id] == new id, relabel() applies it. Edge direction is
+  ignored when ordering. A Graph goes through Graph::from_csr(relabel(graph.csr(), p)).
+*/
+
+// Breadth first from the smallest unvisited vertex
+std::vector<std::uint32_t> bfs_permutation(const GraphCsrView& graph);
+
+// Reverse Cuthill-McKee: BFS from a minimal degree vertex, neighbours by
+// increasing degree, the whole order reversed. Keeps the bandwidth small.
+std::vector<std::uint32_t> rcm_permutation(const GraphCsrView& graph);
+
+// By decreasing degree, hubs first; ties keep the old order
+std::vector<std::uint32_t> degree_permutation(const GraphCsrView& graph);
+
+/*
+  Greedy Gorder-like placement: the next vertex is the one with the most
+  neighbours and siblings (shared neighbours) among the last window placed
+  ones. Siblings through vertices of degree above hub_degree are not counted,
+  they would make the pass quadratic.
+*/
+std::vector<std::uint32_t> gorder_permutation(const GraphCsrView& graph, size_t window = 5,
+                                              size_t hub_degree = 256);
+
+// Same graph with vertex i renamed to permutation[i], adjacency sorted by target
+GraphCsr relabel(const GraphCsr& graph, const std::vector<std::uint32_t>& permutation);
+
+/*
+  Label propagation k-way partitioning. Starts from contiguous blocks of
+  the BFS order, then every vertex moves to the part most of its neighbours
+  are in while the part stays under (1 + imbalance) * nodes / parts.
+  Returns the part of every vertex.
+*/
+std::vector<std::uint32_t> partition(const GraphCsrView& graph, std::uint32_t parts,
+                                     size_t iterations = 10, double imbalance = 0.03);
+
+// Edges whose ends are in different parts
+size_t cut_edges(const GraphCsrView& graph, const std::vector<std::uint32_t>& parts);
+
+} // namespace Container
@@ -0,0 +1,211 @@
+#include "graph_search.hpp"
+
+#include <cassert>
+#include <numeric>
+
+namespace Container {
+
+GraphCsr transpose(const GraphCsr& graph)
+{
+  const auto n = graph.node_count();
+
+  GraphCsr result;
+  result.labels = graph.labels;
+  result.offsets.assign(n + 1, 0);
+  result.targets.resize(graph.edge_count());
+  result.weights.resize(graph.edge_count());
+
+  for (const auto v : graph.targets)
+    ++result.offsets[v + 1];
+
+  std::partial_sum(result.offsets.begin(), result.offsets.end(), result.offsets.begin());
+
+  std::vector<std::uint64_t> fill(result.offsets.begin(), result.offsets.end() - 1);
+
+  // sources come in increasing order, so every reversed list stays sorted
+  for (size_t u = 0; u < n; ++u) {
+    for (auto e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+      const auto slot = fill[graph.targets[e]]++;
+      result.targets[slot] = static_cast<std::uint32_t>(u);
+      result.weights[slot] = graph.weights[e];
+    }
+  }
+
+  return result;
+}
+
+
+RouteSearch::Side::Side(size_t size)
+  : dist(size, unreachable_distance)
+  , parent(size, none)
+  , heap(size)
+{ }
+
+void RouteSearch::Side::reset()
+{
+  for (const auto u : touched) {
+    dist[u] = unreachable_distance;
+    parent[u] = none;
+  }
+
+  touched.clear();
+  heap.clear();
+}
+
+void RouteSearch::Side::reach(std::uint32_t u, std::uint64_t d, std::uint32_t from)
+{
+  if (dist[u] == unreachable_distance)
+    touched.push_back(u);
+
+  dist[u] = d;
+  parent[u] = from;
+}
+
+void RouteSearch::Side::trace(std::uint32_t u, std::vector<std::uint32_t>& out) const
+{
+  for (; u != none; u = parent[u])
+    out.push_back(u);
+}
+
+
+RouteSearch::RouteSearch(const GraphCsrView& forward, const GraphCsrView& backward)
+  : forward_(forward)
+  , backward_(backward)
+  , ahead_(forward.node_count())
+  , behind_(backward.node_count())
+{ }
+
+
+Route RouteSearch::bidirectional(std::uint32_t source, std::uint32_t target)
+{
+  assert(backward_.node_count() == forward_.node_count());
+
+  Route route;
+
+  if (source >= forward_.node_count() || target >= forward_.node_count())
+    return route;
+
+  ahead_.reset();
+  behind_.reset();
+
+  ahead_.reach(source, 0, none);
+  ahead_.heap.push(source, 0);
+
+  behind_.reach(target, 0, none);
+  behind_.heap.push(target, 0);
+
+  auto best = source == target ? 0 : unreachable_distance;
+  auto meeting = source == target ? source : none;
+
+  const auto top = [](const Side& side) {
+    return side.heap.empty() ? unreachable_distance : side.heap.top_value();
+  };
+
+  while (true) {
+    const auto forward_top = top(ahead_);
+    const auto backward_top = top(behind_);
+
+    // an empty queue ends the search as well
+    if (forward_top == unreachable_distance || backward_top == unreachable_distance ||
+        forward_top + backward_top >= best)
+      break;
+
+    const bool forward = forward_top <= backward_top;
+
+    auto& side = forward ? ahead_ : behind_;
+    const auto& other = forward ? behind_ : ahead_;
+    const auto& graph = forward ? forward_ : backward_;
+
+    const auto u = static_cast<std::uint32_t>(side.heap.top());
+    side.heap.pop();
+    ++route.settled;
+
+    for (auto e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+      const auto v = graph.targets[e];
+      const auto candidate = side.dist[u] + graph.weights[e];
+
+      if (candidate >= side.dist[v])
+        continue;
+
+      side.reach(v, candidate, u);
+      side.heap.push_or_decrease(v, candidate);
+
+      if (other.dist[v] != unreachable_distance && candidate + other.dist[v] < best) {
+        best = candidate + other.dist[v];
+        meeting = v;
+      }
+    }
+  }
+
+  if (meeting == none)
+    return route;
+
+  route.distance = best;
+
+  ahead_.trace(meeting, route.path);
+  std::reverse(route.path.begin(), route.path.end());
+
+  // backward parents lead from the meeting node on to target
+  route.path.pop_back();
+  behind_.trace(meeting, route.path);
+
+  return route;
+}
+
+
+Landmarks::Landmarks(const GraphCsrView& forward, const GraphCsrView& backward, size_t count)
+{
+  const auto n = forward.node_count();
+  count = std::min(count, n);
+
+  from_.resize(n * count);
+  to_.resize(n * count);
+
+  // farthest point selection: the next landmark is the node farthest
+  // from all chosen ones, unreachable nodes first
+  std::vector<std::uint64_t> nearest(n, unreachable_distance);
+  std::uint32_t next = 0;
+
+  for (size_t i = 0; i < count; ++i) {
+    landmarks_.push_back(next);
+
+    const auto from = dijkstra(forward, next);
+    const auto to = dijkstra(backward, next);
+
+    for (size_t u = 0; u < n; ++u) {
+      from_[u * count + i] = from[u];
+      to_[u * count + i] = to[u];
+      nearest[u] = std::min(nearest[u], from[u]);
+    }
+
+    next = static_cast<std::uint32_t>(std::max_element(nearest.begin(), nearest.end()) - nearest.begin());
+  }
+}
+
+std::uint64_t Landmarks::lower_bound(std::uint32_t u, std::uint32_t target) const
+{
+  const auto count = landmarks_.size();
+  std::uint64_t result = 0;
+
+  for (size_t i = 0; i < count; ++i) {
+    const auto from_u = from_[u * count + i];
+    const auto from_t = from_[target * count + i];
+    const auto to_u = to_[u * count + i];
+    const auto to_t = to_[target * count + i];
+
+    // L -> u -> t or u -> t -> L would exist
+    if ((from_u != unreachable_distance && from_t == unreachable_distance) ||
+        (to_t != unreachable_distance && to_u == unreachable_distance))
+      return unreachable_distance;
+
+    if (from_u != unreachable_distance && from_t > from_u)
+      result = std::max(result, from_t - from_u);
+
+    if (to_t != unreachable_distance && to_u > to_t)
+      result = std::max(result, to_u - to_t);
+  }
+
+  return result;
+}
+
+} // namespace Container
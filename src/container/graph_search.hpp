@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef> // size_t
+#include <limits>
+#include <vector>
+
+#include "graph_csr.hpp"
+#include "graph_sssp.hpp"
+#include "indexed_heap.hpp"
+
+namespace Container {
+
+struct Route
+{
+  std::uint64_t distance = unreachable_distance;
+  std::vector<std::uint32_t> path; // source ... target, empty when unreachable
+  size_t settled = 0;              // nodes taken from the queue
+};
+
+// Same vertices and labels, every edge reversed
+GraphCsr transpose(const GraphCsr& graph);
+
+
+/*
+  Point to point searches that stop once the target is settled. The scratch
+  arrays are kept between queries and only the touched entries are reset,
+  so a query costs what it visits rather than the size of the graph.
+*/
+class RouteSearch
+{
+public:
+  // backward is the transpose of forward, only bidirectional() needs it
+  explicit RouteSearch(const GraphCsrView& forward, const GraphCsrView& backward = {});
+
+  // Dijkstra from both ends, stops when the two queues together cannot beat the best meeting
+  Route bidirectional(std::uint32_t source, std::uint32_t target);
+
+  // heuristic(u) is a lower bound of the distance from u to target,
+  // unreachable_distance when target cannot be reached from u
+  template <class Heuristic>
+  Route astar(std::uint32_t source, std::uint32_t target, Heuristic heuristic);
+
+private:
+  static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+  struct Side
+  {
+    std::vector<std::uint64_t> dist;
+    std::vector<std::uint32_t> parent;
+    std::vector<std::uint32_t> touched;
+    IndexedHeap<std::uint64_t> heap;
+
+    explicit Side(size_t size);
+
+    void reset();
+    void reach(std::uint32_t u, std::uint64_t d, std::uint32_t from);
+
+    // u, parent of u, ... up to the root of the search
+    void trace(std::uint32_t u, std::vector<std::uint32_t>& out) const;
+  };
+
+  GraphCsrView forward_;
+  GraphCsrView backward_;
+
+  Side ahead_;
+  Side behind_;
+};
+
+
+/*
+  ALT lower bounds. Distances to and from a few landmarks picked far from
+  each other give d(u, t) >= d(L, t) - d(L, u) and d(u, t) >= d(u, L) - d(t, L)
+  by the triangle inequality.
+*/
+class Landmarks
+{
+public:
+  Landmarks(const GraphCsrView& forward, const GraphCsrView& backward, size_t count);
+
+  // unreachable_distance when a landmark proves target unreachable from u
+  std::uint64_t lower_bound(std::uint32_t u, std::uint32_t target) const;
+
+  const std::vector<std::uint32_t>& landmarks() const { return landmarks_; }
+
+private:
+  std::vector<std::uint32_t> landmarks_;
+  std::vector<std::uint64_t> from_; // [u * count + i] = d(landmark i, u)
+  std::vector<std::uint64_t> to_;   // [u * count + i] = d(u, landmark i)
+};
+
+
+template <class Heuristic>
+Route RouteSearch::astar(std::uint32_t source, std::uint32_t target, Heuristic heuristic)
+{
+  Route route;
+
+  if (source >= forward_.node_count() || target >= forward_.node_count())
+    return route;
+
+  ahead_.reset();
+  ahead_.reach(source, 0, none);
+  ahead_.heap.push(source, heuristic(source));
+
+  while (!ahead_.heap.empty()) {
+    const auto u = static_cast<std::uint32_t>(ahead_.heap.top());
+    ahead_.heap.pop();
+    ++route.settled;
+
+    if (u == target) {
+      route.distance = ahead_.dist[u];
+      ahead_.trace(u, route.path);
+      std::reverse(route.path.begin(), route.path.end());
+      break;
+    }
+
+    for (auto e = forward_.offsets[u]; e < forward_.offsets[u + 1]; ++e) {
+      const auto v = forward_.targets[e];
+      const auto candidate = ahead_.dist[u] + forward_.weights[e];
+
+      if (candidate >= ahead_.dist[v])
+        continue;
+
+      const auto estimate = heuristic(v);
+
+      if (estimate == unreachable_distance)
+        continue;
+
+      // a node settled too early is queued again, heuristic need not be consistent
+      ahead_.reach(v, candidate, u);
+      ahead_.heap.push_or_decrease(v, candidate + estimate);
+    }
+  }
+
+  return route;
+}
+
+} // namespace Container
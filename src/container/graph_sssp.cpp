@@ -0,0 +1,267 @@
+#include "graph_sssp.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "indexed_heap.hpp"
+
+namespace Container {
+
+namespace {
+
+class Barrier
+{
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  const size_t count_;
+  size_t waiting_ = 0;
+  size_t generation_ = 0;
+
+public:
+  explicit Barrier(size_t count) : count_(count) { }
+
+  void wait()
+  {
+    std::unique_lock lock(mutex_);
+    const auto generation = generation_;
+
+    if (++waiting_ == count_) {
+      waiting_ = 0;
+      ++generation_;
+      cv_.notify_all();
+      return;
+    }
+
+    cv_.wait(lock, [this, generation] { return generation != generation_; });
+  }
+};
+
+
+class DeltaStepping
+{
+  using Bucket = std::vector<std::uint32_t>;
+
+  const GraphCsrView& graph_;
+  const std::uint64_t delta_;
+  const size_t threads_;
+
+  std::vector<std::atomic<std::uint64_t>> dist_;
+
+  // buckets_[thread][bucket % buckets_count_]: live distances never span
+  // more than max coast / delta + 1 buckets, so they can be reused cyclically
+  size_t bucket_count_;
+  std::vector<std::vector<Bucket>> buckets_;
+  std::vector<Bucket> settled_;
+
+  // frontiers_[thread]: the current bucket of the thread, taken over as a
+  // whole; all of them together are relaxed in equal slices
+  std::vector<Bucket> frontiers_;
+
+  Barrier barrier_;
+
+  // written by thread 0 between barriers
+  std::uint64_t current_ = 0;
+  bool done_ = false;
+
+public:
+  DeltaStepping(const GraphCsrView& graph, std::uint64_t delta, size_t threads)
+    : graph_(graph)
+    , delta_(std::max<std::uint64_t>(delta, 1))
+    , threads_(threads)
+    , dist_(graph.node_count())
+    , buckets_(threads)
+    , settled_(threads)
+    , frontiers_(threads)
+    , barrier_(threads)
+  {
+    std::uint64_t max_coast = 0;
+    for (size_t e = 0; e < graph.edge_count(); ++e)
+      max_coast = std::max<std::uint64_t>(max_coast, graph.weights[e]);
+
+    bucket_count_ = max_coast / delta_ + 2;
+
+    for (auto& buckets : buckets_)
+      buckets.resize(bucket_count_);
+
+    for (auto& d : dist_)
+      d.store(unreachable_distance, std::memory_order_relaxed);
+  }
+
+  std::vector<std::uint64_t> run(std::uint32_t source)
+  {
+    dist_[source].store(0, std::memory_order_relaxed);
+    buckets_[0][0].push_back(source);
+
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < threads_; ++t)
+      workers.emplace_back([this, t] { work(t); });
+
+    work(0);
+
+    for (auto& worker : workers)
+      worker.join();
+
+    std::vector<std::uint64_t> result(dist_.size());
+    for (size_t u = 0; u < dist_.size(); ++u)
+      result[u] = dist_[u].load(std::memory_order_relaxed);
+
+    return result;
+  }
+
+private:
+  void work(size_t t)
+  {
+    while (true) {
+      if (t == 0)
+        select_bucket();
+
+      barrier_.wait();
+
+      if (done_)
+        return;
+
+      // light edges may refill the current bucket, repeat until it stays empty
+      while (true) {
+        auto& frontier = frontiers_[t];
+        frontier.clear();
+        frontier.swap(buckets_[t][current_ % bucket_count_]);
+
+        barrier_.wait();
+
+        // every thread sees the same frontiers, so all of them stop together
+        if (!relax_frontiers(t))
+          break;
+
+        barrier_.wait();
+      }
+
+      for (const auto u : settled_[t])
+        relax(t, u, false);
+
+      settled_[t].clear();
+      barrier_.wait();
+    }
+  }
+
+  // lowest bucket that any thread holds nodes in
+  void select_bucket()
+  {
+    for (auto b = current_; b < current_ + bucket_count_; ++b) {
+      for (const auto& buckets : buckets_) {
+        if (!buckets[b % bucket_count_].empty()) {
+          current_ = b;
+          return;
+        }
+      }
+    }
+
+    done_ = true;
+  }
+
+  // relaxes slice t of all frontiers taken in thread order, false when they
+  // are all empty
+  bool relax_frontiers(size_t t)
+  {
+    size_t size = 0;
+    for (const auto& frontier : frontiers_)
+      size += frontier.size();
+
+    if (size == 0)
+      return false;
+
+    const auto first = size * t / threads_;
+    const auto last = size * (t + 1) / threads_;
+
+    size_t offset = 0;
+
+    for (const auto& frontier : frontiers_) {
+      if (offset >= last)
+        break;
+
+      const auto begin = std::max(first, offset);
+      const auto end = std::min(last, offset + frontier.size());
+
+      for (auto i = begin; i < end; ++i) {
+        const auto u = frontier[i - offset];
+
+        // stale entry, u moved to a lower bucket meanwhile
+        if (dist_[u].load(std::memory_order_relaxed) / delta_ != current_)
+          continue;
+
+        settled_[t].push_back(u);
+        relax(t, u, true);
+      }
+
+      offset += frontier.size();
+    }
+
+    return true;
+  }
+
+  void relax(size_t t, std::uint32_t u, bool light)
+  {
+    const auto du = dist_[u].load(std::memory_order_relaxed);
+
+    for (auto e = graph_.offsets[u]; e < graph_.offsets[u + 1]; ++e) {
+      const std::uint64_t coast = graph_.weights[e];
+
+      if ((coast <= delta_) != light)
+        continue;
+
+      const auto v = graph_.targets[e];
+      const auto candidate = du + coast;
+      auto current = dist_[v].load(std::memory_order_relaxed);
+
+      while (candidate < current) {
+        if (dist_[v].compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+          buckets_[t][(candidate / delta_) % bucket_count_].push_back(v);
+          break;
+        }
+      }
+    }
+  }
+};
+
+} // namespace
+
+
+std::vector<std::uint64_t> dijkstra(const GraphCsrView& graph, std::uint32_t source)
+{
+  std::vector<std::uint64_t> dist(graph.node_count(), unreachable_distance);
+  IndexedHeap<std::uint64_t> heap(graph.node_count());
+
+  dist[source] = 0;
+  heap.push(source, 0);
+
+  while (!heap.empty()) {
+    const auto u = heap.top();
+    heap.pop();
+
+    for (auto e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+      const auto v = graph.targets[e];
+      const auto candidate = dist[u] + graph.weights[e];
+
+      if (candidate < dist[v]) {
+        dist[v] = candidate;
+        heap.push_or_decrease(v, candidate);
+      }
+    }
+  }
+
+  return dist;
+}
+
+
+std::vector<std::uint64_t> delta_stepping(const GraphCsrView& graph, std::uint32_t source,
+                                          std::uint64_t delta, size_t threads)
+{
+  if (source >= graph.node_count())
+    return std::vector<std::uint64_t>(graph.node_count(), unreachable_distance);
+
+  DeltaStepping algorithm(graph, delta, std::max<size_t>(threads, 1));
+  return algorithm.run(source);
+}
+
+} // namespace Container
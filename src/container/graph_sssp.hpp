@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef> // size_t
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "graph_csr.hpp"
+
+namespace Container {
+
+constexpr std::uint64_t unreachable_distance = std::numeric_limits<std::uint64_t>::max();
+
+// Single source shortest distances, unreachable_distance for unreachable nodes
+std::vector<std::uint64_t> dijkstra(const GraphCsrView& graph, std::uint32_t source);
+
+/*
+  Parallel delta-stepping. Nodes wait in buckets of width delta, every thread
+  owns its own buckets. The current bucket is settled by rounds of light
+  edge (coast <= delta) relaxations over the current buckets of all threads
+  in equal slices, heavy edges are relaxed once per bucket.
+  Small delta approaches Dijkstra, large delta approaches Bellman-Ford; the
+  average edge coast is a reasonable start. Distances are the same as the
+  ones of dijkstra().
+*/
+std::vector<std::uint64_t> delta_stepping(const GraphCsrView& graph, std::uint32_t source,
+                                          std::uint64_t delta,
+                                          size_t threads = std::thread::hardware_concurrency());
+
+} // namespace Container
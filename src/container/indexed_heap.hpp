@@ -0,0 +1,235 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <functional> // std::less
+#include <limits>
+#include <utility>
+#include <cassert>
+
+namespace Container {
+
+// D-ary heap over dense ids [0, capacity) (vertex ids, task ids...). It keeps
+// the position of every id, so decrease_key by id is O(log n).
+template <class T, size_t Arity = 4, class Compare = std::less<T>>
+class IndexedHeap
+{
+  static_assert(Arity >= 2, "heap arity must be at least 2");
+
+public:
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+  explicit IndexedHeap(size_t capacity = 0, const Compare& compare = Compare());
+
+  size_t size() const;
+  bool empty() const;
+  size_t capacity() const;
+
+  void reserve(size_t capacity);
+  void clear();
+
+  bool contains(size_t id) const;
+  const T& value(size_t id) const;
+
+  size_t top() const;
+  const T& top_value() const;
+
+  void push(size_t id, const T& value);
+  void pop();
+
+  // value must not go after the current one
+  void decrease_key(size_t id, const T& value);
+
+  // Pushes id, or decreases its key when value goes first. Returns whether
+  // the heap changed, the usual relaxation step of shortest path searches.
+  bool push_or_decrease(size_t id, const T& value);
+
+private:
+  std::vector<size_t> heap_;     // ids in heap order
+  std::vector<size_t> position_; // id -> index in heap_, npos if absent
+  std::vector<T> values_;        // id -> key
+  Compare compare_;
+
+  bool before(size_t lhs, size_t rhs) const;
+  void place(size_t index, size_t id);
+
+  void sift_up(size_t index);
+  void sift_down(size_t index);
+};
+
+
+template <class T, size_t Arity, class Compare>
+IndexedHeap<T, Arity, Compare>::IndexedHeap(size_t capacity, const Compare& compare)
+  : position_(capacity, npos)
+  , values_(capacity)
+  , compare_(compare)
+{ }
+
+
+template <class T, size_t Arity, class Compare>
+size_t IndexedHeap<T, Arity, Compare>::size() const { return heap_.size(); }
+
+template <class T, size_t Arity, class Compare>
+bool IndexedHeap<T, Arity, Compare>::empty() const { return heap_.empty(); }
+
+template <class T, size_t Arity, class Compare>
+size_t IndexedHeap<T, Arity, Compare>::capacity() const { return position_.size(); }
+
+
+template <class T, size_t Arity, class Compare>
+void IndexedHeap<T, Arity, Compare>::reserve(size_t capacity)
+{
+  if (capacity > position_.size()) {
+    position_.resize(capacity, npos);
+    values_.resize(capacity);
+  }
+}
+
+template <class T, size_t Arity, class Compare>
+void IndexedHeap<T, Arity, Compare>::clear()
+{
+  for (const auto id : heap_)
+    position_[id] = npos;
+
+  heap_.clear();
+}
+
+
+template <class T, size_t Arity, class Compare>
+bool IndexedHeap<T, Arity, Compare>::contains(size_t id) const
+{
+  return id < position_.size() && position_[id] != npos;
+}
+
+template <class T, size_t Arity, class Compare>
+const T& IndexedHeap<T, Arity, Compare>::value(size_t id) const { return values_[id]; }
+
+
+template <class T, size_t Arity, class Compare>
+size_t IndexedHeap<T, Arity, Compare>::top() const
+{
+  assert(!heap_.empty());
+  return heap_.front();
+}
+
+template <class T, size_t Arity, class Compare>
+const T& IndexedHeap<T, Arity, Compare>::top_value() const { return values_[top()]; }
+
+
+template <class T, size_t Arity, class Compare>
+void IndexedHeap<T, Arity, Compare>::push(size_t id, const T& value)
+{
+  reserve(id + 1);
+  assert(position_[id] == npos);
+
+  values_[id] = value;
+  heap_.push_back(id);
+  position_[id] = heap_.size() - 1;
+
+  sift_up(heap_.size() - 1);
+}
+
+template <class T, size_t Arity, class Compare>
+void IndexedHeap<T, Arity, Compare>::pop()
+{
+  assert(!heap_.empty());
+
+  position_[heap_.front()] = npos;
+
+  const auto last = heap_.back();
+  heap_.pop_back();
+
+  if (!heap_.empty()) {
+    place(0, last);
+    sift_down(0);
+  }
+}
+
+
+template <class T, size_t Arity, class Compare>
+void IndexedHeap<T, Arity, Compare>::decrease_key(size_t id, const T& value)
+{
+  assert(contains(id) && !compare_(values_[id], value));
+
+  values_[id] = value;
+  sift_up(position_[id]);
+}
+
+template <class T, size_t Arity, class Compare>
+bool IndexedHeap<T, Arity, Compare>::push_or_decrease(size_t id, const T& value)
+{
+  if (!contains(id)) {
+    push(id, value);
+    return true;
+  }
+
+  if (!compare_(value, values_[id]))
+    return false;
+
+  decrease_key(id, value);
+  return true;
+}
+
+
+template <class T, size_t Arity, class Compare>
+bool IndexedHeap<T, Arity, Compare>::before(size_t lhs, size_t rhs) const
+{
+  return compare_(values_[lhs], values_[rhs]);
+}
+
+template <class T, size_t Arity, class Compare>
+void IndexedHeap<T, Arity, Compare>::place(size_t index, size_t id)
+{
+  heap_[index] = id;
+  position_[id] = index;
+}
+
+
+template <class T, size_t Arity, class Compare>
+void IndexedHeap<T, Arity, Compare>::sift_up(size_t index)
+{
+  const auto id = heap_[index];
+
+  while (index > 0) {
+    const auto parent = (index - 1) / Arity;
+
+    if (!before(id, heap_[parent]))
+      break;
+
+    place(index, heap_[parent]);
+    index = parent;
+  }
+
+  place(index, id);
+}
+
+template <class T, size_t Arity, class Compare>
+void IndexedHeap<T, Arity, Compare>::sift_down(size_t index)
+{
+  const auto size = heap_.size();
+  const auto id = heap_[index];
+
+  while (true) {
+    const auto first = index * Arity + 1;
+
+    if (first >= size)
+      break;
+
+    const auto last = std::min(first + Arity, size);
+
+    auto best = first;
+    for (auto i = first + 1; i < last; ++i)
+      if (before(heap_[i], heap_[best]))
+        best = i;
+
+    if (!before(heap_[best], id))
+      break;
+
+    place(index, heap_[best]);
+    index = best;
+  }
+
+  place(index, id);
+}
+
+} // namespace Container
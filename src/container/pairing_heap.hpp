@@ -0,0 +1,231 @@
+#pragma once
+
+#include <vector>
+#include <functional> // std::less
+#include <limits>
+#include <cassert>
+
+namespace Container::Detail {
+
+template <class T>
+struct PairingHeapNode
+{
+  T value;
+  size_t child;
+  size_t sibling;
+  size_t prev; // parent for the leftmost child, left sibling otherwise
+};
+
+}
+
+namespace Container {
+
+// Pairing heap whose nodes live in one vector and link each other by index.
+// push returns a handle which stays valid until the element is popped.
+template <class T, class Compare = std::less<T>>
+class PairingHeap
+{
+public:
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+  explicit PairingHeap(const Compare& compare = Compare());
+
+  size_t size() const;
+  bool empty() const;
+
+  void reserve(size_t capacity);
+  void clear();
+
+  const T& top() const;
+  size_t top_handle() const;
+
+  const T& value(size_t handle) const;
+
+  size_t push(const T& value);
+  void pop();
+
+  // value must not go after the current one
+  void decrease_key(size_t handle, const T& value);
+
+private:
+  using Node = Detail::PairingHeapNode<T>;
+
+  std::vector<Node> nodes_;
+  std::vector<size_t> free_;
+  std::vector<size_t> pairs_; // scratch of merge_pairs
+  size_t root_;
+  size_t size_;
+  Compare compare_;
+
+  size_t meld(size_t lhs, size_t rhs);
+  size_t merge_pairs(size_t first);
+};
+
+
+template <class T, class Compare>
+PairingHeap<T, Compare>::PairingHeap(const Compare& compare)
+  : root_(npos)
+  , size_(0)
+  , compare_(compare)
+{ }
+
+
+template <class T, class Compare>
+size_t PairingHeap<T, Compare>::size() const { return size_; }
+
+template <class T, class Compare>
+bool PairingHeap<T, Compare>::empty() const { return size_ == 0; }
+
+
+template <class T, class Compare>
+void PairingHeap<T, Compare>::reserve(size_t capacity) { nodes_.reserve(capacity); }
+
+template <class T, class Compare>
+void PairingHeap<T, Compare>::clear()
+{
+  nodes_.clear();
+  free_.clear();
+  root_ = npos;
+  size_ = 0;
+}
+
+
+template <class T, class Compare>
+const T& PairingHeap<T, Compare>::top() const
+{
+  assert(root_ != npos);
+  return nodes_[root_].value;
+}
+
+template <class T, class Compare>
+size_t PairingHeap<T, Compare>::top_handle() const { return root_; }
+
+template <class T, class Compare>
+const T& PairingHeap<T, Compare>::value(size_t handle) const { return nodes_[handle].value; }
+
+
+template <class T, class Compare>
+size_t PairingHeap<T, Compare>::push(const T& value)
+{
+  size_t handle;
+
+  if (free_.empty()) {
+    handle = nodes_.size();
+    nodes_.push_back({value, npos, npos, npos});
+  } else {
+    handle = free_.back();
+    free_.pop_back();
+    nodes_[handle] = {value, npos, npos, npos};
+  }
+
+  root_ = meld(root_, handle);
+  ++size_;
+
+  return handle;
+}
+
+template <class T, class Compare>
+void PairingHeap<T, Compare>::pop()
+{
+  assert(root_ != npos);
+
+  const auto old = root_;
+  root_ = merge_pairs(nodes_[old].child);
+
+  free_.push_back(old);
+  --size_;
+}
+
+
+template <class T, class Compare>
+void PairingHeap<T, Compare>::decrease_key(size_t handle, const T& value)
+{
+  auto& node = nodes_[handle];
+  assert(!compare_(node.value, value));
+
+  node.value = value;
+
+  if (handle == root_)
+    return;
+
+  // cut the subtree out and meld it with the root
+  auto& prev = nodes_[node.prev];
+
+  if (prev.child == handle)
+    prev.child = node.sibling;
+  else
+    prev.sibling = node.sibling;
+
+  if (node.sibling != npos)
+    nodes_[node.sibling].prev = node.prev;
+
+  node.sibling = npos;
+  node.prev = npos;
+
+  root_ = meld(root_, handle);
+}
+
+
+template <class T, class Compare>
+size_t PairingHeap<T, Compare>::meld(size_t lhs, size_t rhs)
+{
+  if (lhs == npos)
+    return rhs;
+
+  if (rhs == npos)
+    return lhs;
+
+  if (compare_(nodes_[rhs].value, nodes_[lhs].value))
+    std::swap(lhs, rhs);
+
+  // rhs becomes the leftmost child of lhs
+  auto& parent = nodes_[lhs];
+  auto& child = nodes_[rhs];
+
+  child.sibling = parent.child;
+  child.prev = lhs;
+
+  if (parent.child != npos)
+    nodes_[parent.child].prev = rhs;
+
+  parent.child = rhs;
+
+  return lhs;
+}
+
+template <class T, class Compare>
+size_t PairingHeap<T, Compare>::merge_pairs(size_t first)
+{
+  pairs_.clear();
+
+  for (auto index = first; index != npos; ) {
+    auto& node = nodes_[index];
+    const auto next = node.sibling;
+
+    node.sibling = npos;
+    node.prev = npos;
+    pairs_.push_back(index);
+
+    index = next;
+  }
+
+  if (pairs_.empty())
+    return npos;
+
+  // left to right: meld neighbours pairwise
+  size_t count = 0;
+  for (size_t i = 0; i < pairs_.size(); i += 2) {
+    pairs_[count++] = i + 1 < pairs_.size()
+      ? meld(pairs_[i], pairs_[i + 1])
+      : pairs_[i];
+  }
+
+  // right to left: meld the pairs into one tree
+  auto root = pairs_[count - 1];
+  for (size_t i = count - 1; i > 0; --i)
+    root = meld(pairs_[i - 1], root);
+
+  return root;
+}
+
+} // namespace Container
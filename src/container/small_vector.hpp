@@ -0,0 +1,348 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef> // size_t
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <utility>
+#include <cassert>
+
+namespace Container {
+
+// Vector keeping its first N elements inside the object itself, the heap
+// is only used once it grows past N. Suited to many short sequences such
+// as adjacency lists of low degree nodes.
+template <class T, size_t N>
+class SmallVector
+{
+  static_assert(N > 0, "small vector needs inline room for at least one element");
+
+public:
+  using value_type = T;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  SmallVector() noexcept;
+  SmallVector(std::initializer_list<T> il);
+
+  SmallVector(const SmallVector& other);
+  SmallVector(SmallVector&& other) noexcept;
+
+  SmallVector& operator= (const SmallVector& other);
+  SmallVector& operator= (SmallVector&& other) noexcept;
+
+  ~SmallVector();
+
+  size_t size() const;
+  size_t capacity() const;
+  bool empty() const;
+
+  // elements still live in the object
+  bool is_inline() const;
+
+  T* data();
+  const T* data() const;
+
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  T& operator[] (size_t index);
+  const T& operator[] (size_t index) const;
+
+  T& front();
+  T& back();
+  const T& front() const;
+  const T& back() const;
+
+  void reserve(size_t capacity);
+  void clear();
+
+  void push_back(const T& value);
+  void push_back(T&& value);
+
+  template <class... Args>
+  T& emplace_back(Args&&... args);
+
+  void pop_back();
+
+  // keeps the order of the rest
+  iterator erase(const_iterator pos);
+
+  // moves the last element into pos, O(1)
+  void erase_unordered(const_iterator pos);
+
+private:
+  T* data_;
+  std::uint32_t size_ = 0;
+  std::uint32_t capacity_ = N;
+  alignas(T) unsigned char inline_[N * sizeof(T)];
+
+  T* inline_data();
+  void release();
+  void steal(SmallVector& other);
+
+  template <class... Args>
+  T& grow_emplace(Args&&... args);
+};
+
+
+template <class T, size_t N>
+SmallVector<T, N>::SmallVector() noexcept
+  : data_(inline_data())
+{ }
+
+template <class T, size_t N>
+SmallVector<T, N>::SmallVector(std::initializer_list<T> il)
+  : SmallVector()
+{
+  reserve(il.size());
+
+  for (const auto& value : il)
+    push_back(value);
+}
+
+template <class T, size_t N>
+SmallVector<T, N>::SmallVector(const SmallVector& other)
+  : SmallVector()
+{
+  reserve(other.size());
+  std::uninitialized_copy(other.begin(), other.end(), data_);
+  size_ = other.size_;
+}
+
+template <class T, size_t N>
+SmallVector<T, N>::SmallVector(SmallVector&& other) noexcept
+  : SmallVector()
+{
+  steal(other);
+}
+
+template <class T, size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator= (const SmallVector& other)
+{
+  if (this != &other) {
+    clear();
+    reserve(other.size());
+    std::uninitialized_copy(other.begin(), other.end(), data_);
+    size_ = other.size_;
+  }
+
+  return *this;
+}
+
+template <class T, size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator= (SmallVector&& other) noexcept
+{
+  if (this != &other) {
+    release();
+    steal(other);
+  }
+
+  return *this;
+}
+
+template <class T, size_t N>
+SmallVector<T, N>::~SmallVector() { release(); }
+
+
+template <class T, size_t N>
+size_t SmallVector<T, N>::size() const { return size_; }
+
+template <class T, size_t N>
+size_t SmallVector<T, N>::capacity() const { return capacity_; }
+
+template <class T, size_t N>
+bool SmallVector<T, N>::empty() const { return size_ == 0; }
+
+template <class T, size_t N>
+bool SmallVector<T, N>::is_inline() const
+{
+  return data_ == reinterpret_cast<const T*>(inline_);
+}
+
+
+template <class T, size_t N>
+T* SmallVector<T, N>::data() { return data_; }
+
+template <class T, size_t N>
+const T* SmallVector<T, N>::data() const { return data_; }
+
+template <class T, size_t N>
+auto SmallVector<T, N>::begin() -> iterator { return data_; }
+
+template <class T, size_t N>
+auto SmallVector<T, N>::end() -> iterator { return data_ + size_; }
+
+template <class T, size_t N>
+auto SmallVector<T, N>::begin() const -> const_iterator { return data_; }
+
+template <class T, size_t N>
+auto SmallVector<T, N>::end() const -> const_iterator { return data_ + size_; }
+
+
+template <class T, size_t N>
+T& SmallVector<T, N>::operator[] (size_t index)
+{
+  assert(index < size_);
+  return data_[index];
+}
+
+template <class T, size_t N>
+const T& SmallVector<T, N>::operator[] (size_t index) const
+{
+  assert(index < size_);
+  return data_[index];
+}
+
+template <class T, size_t N>
+T& SmallVector<T, N>::front() { return (*this)[0]; }
+
+template <class T, size_t N>
+T& SmallVector<T, N>::back() { return (*this)[size_ - 1]; }
+
+template <class T, size_t N>
+const T& SmallVector<T, N>::front() const { return (*this)[0]; }
+
+template <class T, size_t N>
+const T& SmallVector<T, N>::back() const { return (*this)[size_ - 1]; }
+
+
+template <class T, size_t N>
+void SmallVector<T, N>::reserve(size_t capacity)
+{
+  if (capacity <= capacity_)
+    return;
+
+  const auto fresh = static_cast<T*>(::operator new(capacity * sizeof(T)));
+
+  std::uninitialized_move(begin(), end(), fresh);
+  std::destroy(begin(), end());
+
+  if (!is_inline())
+    ::operator delete(data_);
+
+  data_ = fresh;
+  capacity_ = static_cast<std::uint32_t>(capacity);
+}
+
+template <class T, size_t N>
+void SmallVector<T, N>::clear()
+{
+  std::destroy(begin(), end());
+  size_ = 0;
+}
+
+
+template <class T, size_t N>
+void SmallVector<T, N>::push_back(const T& value) { emplace_back(value); }
+
+template <class T, size_t N>
+void SmallVector<T, N>::push_back(T&& value) { emplace_back(std::move(value)); }
+
+template <class T, size_t N>
+template <class... Args>
+T& SmallVector<T, N>::emplace_back(Args&&... args)
+{
+  if (size_ == capacity_)
+    return grow_emplace(std::forward<Args>(args)...);
+
+  const auto result = ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+  ++size_;
+
+  return *result;
+}
+
+template <class T, size_t N>
+void SmallVector<T, N>::pop_back()
+{
+  assert(size_ > 0);
+  std::destroy_at(data_ + --size_);
+}
+
+
+template <class T, size_t N>
+auto SmallVector<T, N>::erase(const_iterator pos) -> iterator
+{
+  const auto it = begin() + (pos - begin());
+
+  std::move(it + 1, end(), it);
+  pop_back();
+
+  return it;
+}
+
+template <class T, size_t N>
+void SmallVector<T, N>::erase_unordered(const_iterator pos)
+{
+  const auto it = begin() + (pos - begin());
+
+  if (it + 1 != end())
+    *it = std::move(back());
+
+  pop_back();
+}
+
+
+template <class T, size_t N>
+T* SmallVector<T, N>::inline_data() { return reinterpret_cast<T*>(inline_); }
+
+template <class T, size_t N>
+void SmallVector<T, N>::release()
+{
+  clear();
+
+  if (!is_inline())
+    ::operator delete(data_);
+
+  data_ = inline_data();
+  capacity_ = N;
+}
+
+// this holds no elements, a heap buffer of other is taken over as is
+template <class T, size_t N>
+void SmallVector<T, N>::steal(SmallVector& other)
+{
+  if (other.is_inline()) {
+    std::uninitialized_move(other.begin(), other.end(), data_);
+    size_ = other.size_;
+    other.clear();
+    return;
+  }
+
+  data_ = other.data_;
+  size_ = other.size_;
+  capacity_ = other.capacity_;
+
+  other.data_ = other.inline_data();
+  other.size_ = 0;
+  other.capacity_ = N;
+}
+
+// the new element is built before the old ones move, args may refer to one of them
+template <class T, size_t N>
+template <class... Args>
+T& SmallVector<T, N>::grow_emplace(Args&&... args)
+{
+  const size_t capacity = std::max<size_t>(capacity_ * 2, 1);
+  const auto fresh = static_cast<T*>(::operator new(capacity * sizeof(T)));
+
+  const auto result = ::new (static_cast<void*>(fresh + size_)) T(std::forward<Args>(args)...);
+
+  std::uninitialized_move(begin(), end(), fresh);
+  std::destroy(begin(), end());
+
+  if (!is_inline())
+    ::operator delete(data_);
+
+  data_ = fresh;
+  capacity_ = static_cast<std::uint32_t>(capacity);
+  ++size_;
+
+  return *result;
+}
+
+} // namespace Container
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <cstddef> // size_t
+
+namespace Container::Detail {
+
+// std::swap and std::sort are not constexpr before C++20
+template <class T>
+constexpr void static_swap(T& lhs, T& rhs)
+{
+  T tmp = lhs;
+  lhs = rhs;
+  rhs = tmp;
+}
+
+template <class T, size_t N>
+constexpr void static_sift_down(std::array<T, N>& values, size_t root, size_t size)
+{
+  for (auto child = root * 2 + 1; child < size; child = root * 2 + 1) {
+    if (child + 1 < size && values[child] < values[child + 1])
+      ++child;
+
+    if (!(values[root] < values[child]))
+      return;
+
+    static_swap(values[root], values[child]);
+    root = child;
+  }
+}
+
+// Heap sort, O(n log n) keeps large tables within the constexpr step limits
+template <class T, size_t N>
+constexpr void static_sort(std::array<T, N>& values)
+{
+  for (auto i = N / 2; i-- > 0; )
+    static_sift_down(values, i, N);
+
+  for (auto size = N; size-- > 1; ) {
+    static_swap(values[0], values[size]);
+    static_sift_down(values, 0, size);
+  }
+}
+
+} // namespace Container::Detail
+
+namespace Container {
+
+/*
+  Search tree over a fixed key set, built entirely at compile time. Keys
+  sit in the FlatBst layout (children of i at 2i + 1 and 2i + 2, the
+  Eytzinger layout) without gaps: the tree is complete whatever the order
+  of the input. A constexpr instance has no startup cost and lives in
+  read-only data.
+
+    constexpr StaticFlatBst codes(std::array{200, 404, 301, 500});
+    static_assert(codes.contains(404));
+*/
+template <class T, size_t N>
+class StaticFlatBst
+{
+public:
+  constexpr explicit StaticFlatBst(const std::array<T, N>& values);
+
+  constexpr size_t size() const { return N; }
+  constexpr bool empty() const { return N == 0; }
+
+  constexpr bool contains(const T& value) const;
+  constexpr std::optional<T> lower_bound(const T& value) const;
+
+  template <class Func> constexpr void lnr_iterate(Func f) const;
+
+private:
+  std::array<T, N> data_{};
+
+  static constexpr size_t left(size_t parent) { return parent * 2 + 1; }
+  static constexpr size_t right(size_t parent) { return parent * 2 + 2; }
+
+  constexpr size_t lower_bound_index(const T& value) const;
+
+  // in-order walk of the layout, handing out the sorted values in turn
+  constexpr void build(const std::array<T, N>& sorted, size_t index, size_t& next);
+
+  template <class Func> constexpr void lnr_iterate(size_t index, Func& f) const;
+};
+
+
+template <class T, size_t N>
+constexpr StaticFlatBst<T, N>::StaticFlatBst(const std::array<T, N>& values)
+{
+  auto sorted = values;
+  Detail::static_sort(sorted);
+
+  size_t next = 0;
+  build(sorted, 0, next);
+}
+
+template <class T, size_t N>
+constexpr bool StaticFlatBst<T, N>::contains(const T& value) const
+{
+  const auto index = lower_bound_index(value);
+  return index < N && !(value < data_[index]);
+}
+
+template <class T, size_t N>
+constexpr std::optional<T> StaticFlatBst<T, N>::lower_bound(const T& value) const
+{
+  const auto index = lower_bound_index(value);
+
+  if (index == N)
+    return std::nullopt;
+
+  return data_[index];
+}
+
+template <class T, size_t N> template <class Func>
+constexpr void StaticFlatBst<T, N>::lnr_iterate(Func f) const { lnr_iterate(0, f); }
+
+
+// The last node the descent turned left at holds the answer
+template <class T, size_t N>
+constexpr size_t StaticFlatBst<T, N>::lower_bound_index(const T& value) const
+{
+  auto found = N;
+
+  for (size_t index = 0; index < N; ) {
+    if (data_[index] < value) {
+      index = right(index);
+    } else {
+      found = index;
+      index = left(index);
+    }
+  }
+
+  return found;
+}
+
+template <class T, size_t N>
+constexpr void StaticFlatBst<T, N>::build(const std::array<T, N>& sorted, size_t index, size_t& next)
+{
+  if (index >= N)
+    return;
+
+  build(sorted, left(index), next);
+  data_[index] = sorted[next++];
+  build(sorted, right(index), next);
+}
+
+template <class T, size_t N> template <class Func>
+constexpr void StaticFlatBst<T, N>::lnr_iterate(size_t index, Func& f) const
+{
+  if (index >= N)
+    return;
+
+  lnr_iterate(left(index), f);
+  f(data_[index]);
+  lnr_iterate(right(index), f);
+}
+
+} // namespace Container
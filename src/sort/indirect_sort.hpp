@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstddef> // size_t
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Sort
+{
+
+/*
+  Permutation sorting first..last by compare, stable: element perm[0]
+  comes first. Records are only read, never moved. Index may be 32 bit
+  to halve the permutation when the range is small enough.
+*/
+template <class Index = size_t, class RandomIt, class Compare = std::less<>>
+std::vector<Index> argsort(RandomIt first, RandomIt last, Compare compare = Compare())
+{
+  const auto n = static_cast<size_t>(std::distance(first, last));
+
+  static_assert(std::is_unsigned_v<Index>, "indices are unsigned");
+  assert(n <= std::numeric_limits<Index>::max());
+
+  std::vector<Index> perm(n);
+  std::iota(perm.begin(), perm.end(), Index(0));
+
+  std::stable_sort(perm.begin(), perm.end(),
+    [first, &compare](Index lhs, Index rhs) {
+      return compare(first[lhs], first[rhs]);
+    }
+  );
+
+  return perm;
+}
+
+/*
+  Reorders first.. so that element perm[i] ends up at position i. Follows
+  the cycles of perm, every element is moved once plus once more per
+  cycle through a temporary. perm is left as the identity.
+*/
+template <class RandomIt, class Index>
+void apply_permutation(RandomIt first, std::vector<Index>& perm)
+{
+  for (size_t i = 0; i < perm.size(); ++i) {
+    if (perm[i] == i)
+      continue;
+
+    auto value = std::move(first[i]);
+    auto hole = i;
+
+    while (perm[hole] != i) {
+      const size_t from = perm[hole];
+
+      first[hole] = std::move(first[from]);
+      perm[hole] = static_cast<Index>(hole);
+      hole = from;
+    }
+
+    first[hole] = std::move(value);
+    perm[hole] = static_cast<Index>(hole);
+  }
+}
+
+namespace Detail
+{
+
+template <class Index, class RandomIt, class KeyFunc, class Compare>
+void sort_by_key(RandomIt first, RandomIt last, KeyFunc& key, Compare& compare)
+{
+  using Key = std::decay_t<std::invoke_result_t<KeyFunc&, decltype(*first)>>;
+
+  const auto n = static_cast<size_t>(std::distance(first, last));
+
+  // compact records: the key and where it came from
+  std::vector<std::pair<Key, Index>> keyed;
+  keyed.reserve(n);
+
+  for (size_t i = 0; i < n; ++i)
+    keyed.emplace_back(std::invoke(key, first[i]), static_cast<Index>(i));
+
+  // the index breaks ties, equal keys keep their order
+  std::sort(keyed.begin(), keyed.end(),
+    [&compare](const auto& lhs, const auto& rhs) {
+      if (compare(lhs.first, rhs.first))
+        return true;
+      if (compare(rhs.first, lhs.first))
+        return false;
+      return lhs.second < rhs.second;
+    }
+  );
+
+  std::vector<Index> perm(n);
+  for (size_t i = 0; i < n; ++i)
+    perm[i] = keyed[i].second;
+
+  keyed.clear();
+  keyed.shrink_to_fit();
+
+  apply_permutation(first, perm);
+}
+
+} // namespace Detail
+
+/*
+  Stable sort by key(record), for heavy records with a costly key. The key
+  is computed once per record into a compact (key, index) array, that
+  array is sorted and the records are then moved into place along the
+  permutation cycles, once each and once more for the first of a cycle.
+  32 bit indices are used when they suffice.
+*/
+template <class RandomIt, class KeyFunc, class Compare = std::less<>>
+void sort_by_key(RandomIt first, RandomIt last, KeyFunc key, Compare compare = Compare())
+{
+  const auto n = static_cast<size_t>(std::distance(first, last));
+
+  if (n <= std::numeric_limits<std::uint32_t>::max())
+    Detail::sort_by_key<std::uint32_t>(first, last, key, compare);
+  else
+    Detail::sort_by_key<std::uint64_t>(first, last, key, compare);
+}
+
+} // namespace Sort
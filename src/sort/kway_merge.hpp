@@ -0,0 +1,346 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef> // size_t
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+namespace Sort
+{
+
+// Sorted input read from an iterator range
+template <class Iterator>
+class RangeSource
+{
+public:
+  RangeSource(Iterator first, Iterator last) : first_(first), last_(last) { }
+
+  bool empty() const { return first_ == last_; }
+  decltype(auto) front() const { return *first_; }
+  void pop() { ++first_; }
+
+private:
+  Iterator first_;
+  Iterator last_;
+};
+
+// Sorted input taken from the front of a queue, the queue is emptied
+template <class Queue>
+class QueueSource
+{
+public:
+  explicit QueueSource(Queue& queue) : queue_(&queue) { }
+
+  bool empty() const { return queue_->empty(); }
+  const auto& front() const { return queue_->front(); }
+  void pop() { queue_->pop(); }
+
+private:
+  Queue* queue_;
+};
+
+
+/*
+  Tournament tree over k sorted sources, yielding their merge one element
+  at a time. Inner nodes keep the loser of the match played there, so
+  taking the smallest element replays one leaf to root path: log k
+  comparisons against the losers, with no sibling lookups.
+
+  Ties go to the source with the lower index, the merge is stable. A
+  source only has to offer empty(), front() and pop().
+*/
+template <class Source, class Compare = std::less<>>
+class LoserTree
+{
+public:
+  using value_type = std::decay_t<decltype(std::declval<const Source&>().front())>;
+
+  // Input iterator pulling the merge lazily
+  class Iterator
+  {
+    friend class LoserTree;
+
+    LoserTree* tree_ = nullptr;
+
+    explicit Iterator(LoserTree* tree) : tree_(tree) { }
+
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = typename LoserTree::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = decltype(std::declval<const Source&>().front());
+
+    Iterator() = default;
+
+    // every iterator equals end once the tree runs dry
+    bool operator== (const Iterator& it) const { return done() == it.done(); }
+    bool operator!= (const Iterator& it) const { return done() != it.done(); }
+
+    reference operator* () const { return tree_->top(); }
+
+    Iterator& operator++ () { tree_->pop(); return *this; }
+    void operator++ (int) { tree_->pop(); }
+
+  private:
+    bool done() const { return !tree_ || tree_->empty(); }
+  };
+
+  explicit LoserTree(std::vector<Source> sources, Compare compare = Compare());
+
+  bool empty() const;
+
+  decltype(auto) top() const { return sources_[tree_[0]].front(); }
+
+  // index of the source top() comes from
+  size_t top_source() const { return tree_[0]; }
+
+  void pop();
+
+  Iterator begin() { return Iterator(this); }
+  Iterator end() { return Iterator(); }
+
+private:
+  std::vector<Source> sources_;
+  std::vector<size_t> tree_; // [0] winner, [1, leaves_) losers
+  size_t leaves_;
+  Compare compare_;
+
+  bool beats(size_t lhs, size_t rhs) const;
+};
+
+
+template <class Source, class Compare>
+LoserTree<Source, Compare>::LoserTree(std::vector<Source> sources, Compare compare)
+  : sources_(std::move(sources))
+  , leaves_(1)
+  , compare_(compare)
+{
+  while (leaves_ < sources_.size())
+    leaves_ *= 2;
+
+  // winners of every subtree, bottom up; leaves past the sources never win
+  std::vector<size_t> winners(2 * leaves_);
+
+  for (size_t i = 0; i < leaves_; ++i)
+    winners[leaves_ + i] = i;
+
+  tree_.assign(leaves_, 0);
+
+  for (size_t node = leaves_ - 1; node >= 1; --node) {
+    const auto lhs = winners[2 * node];
+    const auto rhs = winners[2 * node + 1];
+
+    const auto lhs_wins = beats(lhs, rhs);
+
+    winners[node] = lhs_wins ? lhs : rhs;
+    tree_[node] = lhs_wins ? rhs : lhs;
+  }
+
+  tree_[0] = winners[1];
+}
+
+template <class Source, class Compare>
+bool LoserTree<Source, Compare>::empty() const
+{
+  return tree_[0] >= sources_.size() || sources_[tree_[0]].empty();
+}
+
+template <class Source, class Compare>
+void LoserTree<Source, Compare>::pop()
+{
+  auto winner = tree_[0];
+  sources_[winner].pop();
+
+  for (auto node = (leaves_ + winner) / 2; node >= 1; node /= 2)
+    if (beats(tree_[node], winner))
+      std::swap(tree_[node], winner);
+
+  tree_[0] = winner;
+}
+
+template <class Source, class Compare>
+bool LoserTree<Source, Compare>::beats(size_t lhs, size_t rhs) const
+{
+  const auto lhs_done = lhs >= sources_.size() || sources_[lhs].empty();
+  const auto rhs_done = rhs >= sources_.size() || sources_[rhs].empty();
+
+  if (lhs_done || rhs_done)
+    return !lhs_done || (rhs_done && lhs < rhs);
+
+  if (compare_(sources_[lhs].front(), sources_[rhs].front()))
+    return true;
+
+  if (compare_(sources_[rhs].front(), sources_[lhs].front()))
+    return false;
+
+  return lhs < rhs;
+}
+
+
+// Stable merge of sorted ranges into out
+template <class Iterator, class OutputIt, class Compare = std::less<>>
+OutputIt kway_merge(const std::vector<std::pair<Iterator, Iterator>>& ranges, OutputIt out,
+                    Compare compare = Compare())
+{
+  std::vector<RangeSource<Iterator>> sources;
+  sources.reserve(ranges.size());
+
+  for (const auto& [first, last] : ranges)
+    sources.emplace_back(first, last);
+
+  LoserTree tree(std::move(sources), compare);
+
+  for (; !tree.empty(); tree.pop())
+    *out++ = tree.top();
+
+  return out;
+}
+
+// Stable merge of sorted queues into out, the queues are emptied
+template <class T, class Container, class OutputIt, class Compare = std::less<>>
+OutputIt kway_merge(std::vector<std::queue<T, Container>>& queues, OutputIt out,
+                    Compare compare = Compare())
+{
+  std::vector<QueueSource<std::queue<T, Container>>> sources;
+  sources.reserve(queues.size());
+
+  for (auto& queue : queues)
+    sources.emplace_back(queue);
+
+  LoserTree tree(std::move(sources), compare);
+
+  for (; !tree.empty(); tree.pop())
+    *out++ = tree.top();
+
+  return out;
+}
+
+
+namespace Detail
+{
+
+/*
+  Multi-sequence selection: cuts the sorted ranges so that the parts before
+  the cuts hold exactly the first rank elements of their stable merge.
+  Elements are ordered by (value, range, position), the element of the
+  given rank is searched by halving the largest window of candidates and
+  ranking its middle element in every range by binary search.
+*/
+template <class RandomIt, class Compare>
+std::vector<size_t> select_cuts(const std::vector<std::pair<RandomIt, RandomIt>>& ranges,
+                                size_t rank, Compare& compare)
+{
+  const auto k = ranges.size();
+
+  std::vector<size_t> lo(k, 0);
+  std::vector<size_t> hi(k);
+  std::vector<size_t> cuts(k);
+
+  size_t total = 0;
+  for (size_t i = 0; i < k; ++i)
+    total += hi[i] = static_cast<size_t>(ranges[i].second - ranges[i].first);
+
+  if (rank >= total)
+    return hi;
+
+  // elements of range i before element (j, q) in merge order
+  const auto before = [&](size_t i, size_t j, size_t q) -> size_t {
+    const auto first = ranges[i].first;
+    const auto last = ranges[i].second;
+    const auto& pivot = ranges[j].first[q];
+
+    if (i == j)
+      return q;
+
+    const auto it = i < j ? std::upper_bound(first, last, pivot, compare)
+                          : std::lower_bound(first, last, pivot, compare);
+
+    return static_cast<size_t>(it - first);
+  };
+
+  for (;;) {
+    size_t m = 0;
+    for (size_t i = 1; i < k; ++i)
+      if (hi[i] - lo[i] > hi[m] - lo[m])
+        m = i;
+
+    const auto q = lo[m] + (hi[m] - lo[m]) / 2;
+
+    size_t position = 0;
+    for (size_t i = 0; i < k; ++i)
+      position += cuts[i] = before(i, m, q);
+
+    if (position == rank)
+      return cuts;
+
+    for (size_t i = 0; i < k; ++i) {
+      if (position < rank)
+        lo[i] = std::max(lo[i], cuts[i] + (i == m));
+      else
+        hi[i] = std::min(hi[i], cuts[i]);
+    }
+  }
+}
+
+} // namespace Detail
+
+/*
+  kway_merge on several threads. The output is cut into equal slices, the
+  inputs are cut to match by multi-sequence selection and every slice is
+  merged by a task of the shared thread pool with a loser tree of its own,
+  writing straight to out, which must be random access. The result is the
+  same stable merge.
+*/
+template <class RandomIt, class RandomOutputIt, class Compare = std::less<>>
+RandomOutputIt parallel_kway_merge(const std::vector<std::pair<RandomIt, RandomIt>>& ranges,
+                                   RandomOutputIt out, Compare compare = Compare(),
+                                   size_t threads = std::thread::hardware_concurrency())
+{
+  static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+                                  typename std::iterator_traits<RandomOutputIt>::iterator_category>,
+                "every slice is written at its own offset of out");
+
+  constexpr size_t min_slice = 1 << 14;
+
+  size_t total = 0;
+  for (const auto& [first, last] : ranges)
+    total += static_cast<size_t>(last - first);
+
+  threads = std::clamp<size_t>(std::min(threads, total / min_slice), 1, 256);
+
+  if (threads == 1)
+    return kway_merge(ranges, out, compare);
+
+  std::vector<std::vector<size_t>> cuts(threads + 1);
+
+  for (size_t t = 0; t <= threads; ++t)
+    cuts[t] = Detail::select_cuts(ranges, total * t / threads, compare);
+
+  Utility::TaskGroup group(Utility::ThreadPool::shared());
+
+  for (size_t t = 0; t < threads; ++t) {
+    group.run([&ranges, &cuts, out, compare, t, rank = total * t / threads] {
+      std::vector<std::pair<RandomIt, RandomIt>> slice;
+      slice.reserve(ranges.size());
+
+      for (size_t i = 0; i < ranges.size(); ++i)
+        slice.emplace_back(ranges[i].first + cuts[t][i], ranges[i].first + cuts[t + 1][i]);
+
+      kway_merge(slice, out + rank, compare);
+    });
+  }
+
+  group.wait();
+
+  return out + total;
+}
+
+} // namespace Sort
@@ -1,48 +1,61 @@
 #pragma once
 
+#include <deque>
 #include <queue>
 
+#include "instrumentation.hpp"
+
 namespace Sort
 {
 
-template <class T>
-void quick_sort(std::queue<T>& q)
+// Instrumented for comparisons, moves, depth and the allocations of the
+// partition queues
+template <class T, class Container>
+void quick_sort(std::queue<T, Container>& q)
 {
   if (q.size() < 2)
     return;
 
-  std::queue<T> lhs; // values less than pivot
-  std::queue<T> equal; // values equal pivot
-  std::queue<T> rhs; // values greater than pivot
+  const Utility::Instrument::Depth depth;
+
+  using Queue = std::queue<T, std::deque<T, Utility::Instrument::CountingAllocator<T>>>;
+
+  Queue lhs; // values less than pivot
+  Queue equal; // values equal pivot
+  Queue rhs; // values greater than pivot
 
-  const auto& pivot = q.front();
+  const auto pivot = q.front();
   
   while (!q.empty()) {
     const auto& value = q.front();
 
-    if (value < pivot)
+    if (Utility::Instrument::less(value, pivot))
       lhs.push(value);
-    else if (pivot < value)
+    else if (Utility::Instrument::less(pivot, value))
       rhs.push(value);
     else // value == pivot
       equal.push(value);
 
+    Utility::Instrument::move();
+
     q.pop();
   }
 
   quick_sort(lhs);
   quick_sort(rhs);
 
-  const auto move_queue = [](std::queue<T>& from, std::queue<T>& to) {
+  const auto move_queue = [&q](Queue& from) {
+    Utility::Instrument::move(from.size());
+
     while (!from.empty()) {
-      to.push(from.front());
+      q.push(from.front());
       from.pop();
     }
   };
 
-  move_queue(lhs, q);
-  move_queue(equal, q);
-  move_queue(rhs, q);
+  move_queue(lhs);
+  move_queue(equal);
+  move_queue(rhs);
 }
 
 } // namespace Sort
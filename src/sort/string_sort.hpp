@@ -0,0 +1,300 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef> // size_t
+#include <cstring>
+#include <iterator>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "indirect_sort.hpp"
+
+namespace Sort
+{
+
+namespace Detail
+{
+
+// A string being sorted: where it lives, where it came from and the
+// 8 characters at the current depth packed big endian into one integer
+struct StringItem
+{
+  const char* data;
+  size_t size;
+  size_t index;
+  std::uint64_t key;
+};
+
+constexpr size_t string_insertion_threshold = 32;
+constexpr size_t string_radix_threshold = 4096;
+
+inline std::uint64_t string_key(const StringItem& item, size_t depth)
+{
+  unsigned char bytes[8] = {};
+
+  if (depth + 8 <= item.size)
+    std::memcpy(bytes, item.data + depth, 8);
+  else if (depth < item.size)
+    std::memcpy(bytes, item.data + depth, item.size - depth);
+
+  std::uint64_t key = 0;
+  for (const auto byte : bytes)
+    key = key << 8 | byte;
+
+  return key;
+}
+
+// Both equal up to depth
+inline bool string_less(const StringItem& lhs, const StringItem& rhs, size_t depth)
+{
+  const auto size = std::min(lhs.size, rhs.size);
+
+  if (depth < size) {
+    const auto cmp = std::memcmp(lhs.data + depth, rhs.data + depth, size - depth);
+    if (cmp != 0)
+      return cmp < 0;
+  }
+
+  return lhs.size < rhs.size;
+}
+
+// Both equal up to depth, keys at depth cached
+inline bool string_less_keyed(const StringItem& lhs, const StringItem& rhs, size_t depth)
+{
+  if (lhs.key != rhs.key)
+    return lhs.key < rhs.key;
+
+  return string_less(lhs, rhs, depth + 8);
+}
+
+inline void string_insertion_sort(StringItem* first, StringItem* last, size_t depth)
+{
+  const auto less = [depth](const StringItem& lhs, const StringItem& rhs) {
+    return string_less_keyed(lhs, rhs, depth);
+  };
+
+  for (auto it = first + 1; it < last; ++it) {
+    const auto item = *it;
+    auto hole = it;
+
+    for (; hole != first && less(item, *(hole - 1)); --hole)
+      *hole = *(hole - 1);
+
+    *hole = item;
+  }
+}
+
+inline void string_sort_range(StringItem* first, StringItem* last, size_t depth, StringItem* scratch, bool keyed = false);
+inline void string_quick_pass(StringItem* first, StringItem* last, size_t depth, StringItem* scratch);
+
+// Common prefix length of two strings equal up to from
+inline size_t common_prefix(const StringItem& lhs, const StringItem& rhs, size_t from = 0)
+{
+  const auto size = std::min(lhs.size, rhs.size);
+  auto i = from;
+
+  for (; i + 8 <= size; i += 8)
+    if (std::memcmp(lhs.data + i, rhs.data + i, 8) != 0)
+      break;
+
+  while (i < size && lhs.data[i] == rhs.data[i])
+    ++i;
+
+  return i;
+}
+
+// Caches the keys at depth and returns it. While reading a string anyway a
+// prefix shared by the whole range is measured, and when it covers a full
+// key the depth jumps past it instead of going 8 characters per pass.
+inline size_t string_keys(StringItem* first, StringItem* last, size_t depth)
+{
+  for (;;) {
+    auto common = first->size;
+
+    for (auto it = first; it != last; ++it) {
+      it->key = string_key(*it, depth);
+
+      if (common >= depth + 8)
+        common = std::min(common, common_prefix(*first, *it, depth));
+    }
+
+    if (common < depth + 8)
+      return depth;
+
+    depth = common;
+  }
+}
+
+// One counting sort pass on the character at depth, ended strings first.
+// The character is the top byte of the cached key, so the split reads no
+// text and the buckets go on with the same keys.
+inline void string_radix_pass(StringItem* first, StringItem* last, size_t depth, StringItem* scratch)
+{
+  const auto bucket = [depth](const StringItem& item) -> size_t {
+    return depth < item.size ? static_cast<size_t>(item.key >> 56) + 1 : 0;
+  };
+
+  size_t offsets[258] = {};
+
+  for (auto it = first; it != last; ++it)
+    ++offsets[bucket(*it) + 1];
+
+  // nothing to split on
+  if (std::count(offsets, offsets + 258, static_cast<size_t>(last - first)) == 1) {
+    string_quick_pass(first, last, depth, scratch);
+    return;
+  }
+
+  for (size_t b = 1; b < 258; ++b)
+    offsets[b] += offsets[b - 1];
+
+  size_t fill[257];
+  std::copy(offsets, offsets + 257, fill);
+
+  for (auto it = first; it != last; ++it)
+    scratch[fill[bucket(*it)]++] = *it;
+
+  std::copy(scratch, scratch + (last - first), first);
+
+  // strings ended at depth are all equal, the keys are still valid for the rest
+  for (size_t b = 1; b < 257; ++b) {
+    const auto bucket_first = first + offsets[b];
+    const auto bucket_last = first + offsets[b + 1];
+
+    if (bucket_last - bucket_first < static_cast<std::ptrdiff_t>(string_insertion_threshold))
+      string_insertion_sort(bucket_first, bucket_last, depth);
+    else
+      string_quick_pass(bucket_first, bucket_last, depth, scratch);
+  }
+}
+
+/*
+  Multikey quicksort over the cached 8 character keys: a three way split
+  on the key, the equal part goes 8 characters deeper at once. Strings
+  ending inside the key are padded with zeros, so they only tie with
+  strings they are a prefix of and sort first, shortest first. The keys
+  stay cached for the unequal parts, the text is read once per depth.
+*/
+inline void string_quick_pass(StringItem* first, StringItem* last, size_t depth, StringItem* scratch)
+{
+  const auto n = static_cast<size_t>(last - first);
+
+  std::uint64_t a = first[0].key;
+  std::uint64_t b = first[n / 2].key;
+  std::uint64_t c = first[n - 1].key;
+
+  const auto pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+  // [first, lt) < pivot, [lt, it) == pivot, [gt, last) > pivot
+  auto lt = first;
+  auto gt = last;
+
+  for (auto it = first; it < gt; ) {
+    if (it->key < pivot)
+      std::swap(*lt++, *it++);
+    else if (it->key > pivot)
+      std::swap(*it, *--gt);
+    else
+      ++it;
+  }
+
+  string_sort_range(first, lt, depth, scratch, true);
+  string_sort_range(gt, last, depth, scratch, true);
+
+  const auto ended = std::partition(lt, gt,
+    [depth](const StringItem& item) {
+      return item.size <= depth + 8;
+    }
+  );
+
+  std::sort(lt, ended,
+    [](const StringItem& lhs, const StringItem& rhs) {
+      return lhs.size < rhs.size;
+    }
+  );
+
+  string_sort_range(ended, gt, depth + 8, scratch);
+}
+
+inline void string_sort_range(StringItem* first, StringItem* last, size_t depth, StringItem* scratch, bool keyed)
+{
+  const auto n = static_cast<size_t>(last - first);
+
+  if (n < 2)
+    return;
+
+  if (!keyed)
+    depth = string_keys(first, last, depth);
+
+  if (n < string_insertion_threshold)
+    string_insertion_sort(first, last, depth);
+  else if (n < string_radix_threshold)
+    string_quick_pass(first, last, depth, scratch);
+  else
+    string_radix_pass(first, last, depth, scratch);
+}
+
+template <class RandomIt>
+void string_sort(RandomIt first, RandomIt last, std::vector<size_t>* lcp)
+{
+  const auto n = static_cast<size_t>(std::distance(first, last));
+
+  std::vector<StringItem> items(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    const std::string_view view(first[i]);
+    items[i] = {view.data(), view.size(), i, 0};
+  }
+
+  std::vector<StringItem> scratch(n < string_radix_threshold ? 0 : n);
+  string_sort_range(items.data(), items.data() + n, 0, scratch.data());
+
+  if (lcp) {
+    lcp->assign(n, 0);
+
+    for (size_t i = 1; i < n; ++i)
+      (*lcp)[i] = common_prefix(items[i - 1], items[i]);
+  }
+
+  std::vector<size_t> perm(n);
+  for (size_t i = 0; i < n; ++i)
+    perm[i] = items[i].index;
+
+  items = {};
+  scratch = {};
+
+  apply_permutation(first, perm);
+}
+
+} // namespace Detail
+
+/*
+  Sorts strings in byte order, the order of std::string::compare. The
+  elements may be std::string, std::string_view or const char*; a range
+  of views or pointers into one arena sorts without touching the text.
+
+  The first 8 characters past the shared prefix are cached per string as
+  one integer. Large ranges are split 256 ways on the first of them (MSD
+  radix), then multikey quicksort partitions on the whole integer and only
+  reads the text again 8 characters further on, so long common prefixes
+  such as URL schemes and hosts are not compared again and again. The
+  strings are sorted as small references and each element is then moved
+  once.
+*/
+template <class RandomIt>
+void string_sort(RandomIt first, RandomIt last)
+{
+  Detail::string_sort(first, last, nullptr);
+}
+
+// Also fills lcp: lcp[i] is the common prefix length of elements i - 1
+// and i after sorting, lcp[0] is 0
+template <class RandomIt>
+void string_sort(RandomIt first, RandomIt last, std::vector<size_t>& lcp)
+{
+  Detail::string_sort(first, last, &lcp);
+}
+
+} // namespace Sort
@@ -0,0 +1,268 @@
+#pragma once
+
+#include <cstddef> // size_t
+#include <cstdint>
+#include <algorithm>
+#include <memory>
+
+#if defined(ALGORITHMS_INSTRUMENTATION)
+#include <atomic>
+#include <mutex>
+#include <vector>
+#endif
+
+/*
+  Opt-in operation counters for the containers and sorts. Built with
+  ALGORITHMS_INSTRUMENTATION defined, the hooks in Instrument count into
+  counters of the calling thread; otherwise they are empty inline functions
+  and compile to nothing. The flag has to be the same for every translation
+  unit of a program.
+*/
+namespace Utility {
+
+#if defined(ALGORITHMS_INSTRUMENTATION)
+constexpr bool instrumentation_enabled = true;
+#else
+constexpr bool instrumentation_enabled = false;
+#endif
+
+struct OperationCounters
+{
+  std::uint64_t allocations = 0;
+  std::uint64_t allocated_bytes = 0;
+  std::uint64_t comparisons = 0;
+  std::uint64_t moves = 0; // element moves and copies
+  std::uint64_t steps = 0; // nodes visited, probe and traversal steps
+  std::uint64_t max_depth = 0; // deepest recursion
+
+  // sums, except max_depth which is the larger of both
+  OperationCounters& operator+= (const OperationCounters& other)
+  {
+    allocations += other.allocations;
+    allocated_bytes += other.allocated_bytes;
+    comparisons += other.comparisons;
+    moves += other.moves;
+    steps += other.steps;
+    max_depth = std::max(max_depth, other.max_depth);
+    return *this;
+  }
+};
+
+} // namespace Utility
+
+#if defined(ALGORITHMS_INSTRUMENTATION)
+
+namespace Utility::Detail {
+
+class ThreadCounters;
+
+// Counters of every live thread, and what exited threads left behind
+struct CounterRegistry
+{
+  std::mutex mutex;
+  std::vector<ThreadCounters*> live;
+  OperationCounters retired;
+};
+
+inline CounterRegistry& counter_registry()
+{
+  static CounterRegistry registry;
+  return registry;
+}
+
+// Written by its own thread only, read by any: relaxed loads and stores
+// are enough and cost no more than plain ones
+class ThreadCounters
+{
+public:
+  ThreadCounters()
+  {
+    auto& registry = counter_registry();
+    std::lock_guard lock(registry.mutex);
+    registry.live.push_back(this);
+  }
+
+  ~ThreadCounters()
+  {
+    auto& registry = counter_registry();
+    std::lock_guard lock(registry.mutex);
+    registry.retired += load();
+    registry.live.erase(std::find(registry.live.begin(), registry.live.end(), this));
+  }
+
+  ThreadCounters(const ThreadCounters&) = delete;
+  ThreadCounters& operator= (const ThreadCounters&) = delete;
+
+  std::atomic<std::uint64_t> allocations{0};
+  std::atomic<std::uint64_t> allocated_bytes{0};
+  std::atomic<std::uint64_t> comparisons{0};
+  std::atomic<std::uint64_t> moves{0};
+  std::atomic<std::uint64_t> steps{0};
+  std::atomic<std::uint64_t> max_depth{0};
+  std::uint64_t depth = 0;
+
+  static void add(std::atomic<std::uint64_t>& counter, std::uint64_t count)
+  {
+    counter.store(counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+  }
+
+  OperationCounters load() const
+  {
+    OperationCounters counters;
+    counters.allocations = allocations.load(std::memory_order_relaxed);
+    counters.allocated_bytes = allocated_bytes.load(std::memory_order_relaxed);
+    counters.comparisons = comparisons.load(std::memory_order_relaxed);
+    counters.moves = moves.load(std::memory_order_relaxed);
+    counters.steps = steps.load(std::memory_order_relaxed);
+    counters.max_depth = max_depth.load(std::memory_order_relaxed);
+    return counters;
+  }
+
+  void reset()
+  {
+    for (auto* counter : {&allocations, &allocated_bytes, &comparisons, &moves, &steps, &max_depth})
+      counter->store(0, std::memory_order_relaxed);
+  }
+};
+
+inline ThreadCounters& thread_counters()
+{
+  thread_local ThreadCounters counters;
+  return counters;
+}
+
+} // namespace Utility::Detail
+
+#endif
+
+namespace Utility {
+
+// Counters of the calling thread
+inline OperationCounters counters_snapshot()
+{
+#if defined(ALGORITHMS_INSTRUMENTATION)
+  return Detail::thread_counters().load();
+#else
+  return {};
+#endif
+}
+
+// Counters of all threads, exited ones included, for a metrics exporter
+inline OperationCounters counters_total()
+{
+#if defined(ALGORITHMS_INSTRUMENTATION)
+  auto& registry = Detail::counter_registry();
+  std::lock_guard lock(registry.mutex);
+
+  auto total = registry.retired;
+  for (const auto* counters : registry.live)
+    total += counters->load();
+
+  return total;
+#else
+  return {};
+#endif
+}
+
+// Zeroes the counters of the calling thread
+inline void counters_reset()
+{
+#if defined(ALGORITHMS_INSTRUMENTATION)
+  Detail::thread_counters().reset();
+#endif
+}
+
+
+// Hooks called by the instrumented code
+namespace Instrument {
+
+inline void allocation([[maybe_unused]] std::size_t bytes)
+{
+#if defined(ALGORITHMS_INSTRUMENTATION)
+  auto& counters = Detail::thread_counters();
+  Detail::ThreadCounters::add(counters.allocations, 1);
+  Detail::ThreadCounters::add(counters.allocated_bytes, bytes);
+#endif
+}
+
+inline void comparison([[maybe_unused]] std::size_t count = 1)
+{
+#if defined(ALGORITHMS_INSTRUMENTATION)
+  Detail::ThreadCounters::add(Detail::thread_counters().comparisons, count);
+#endif
+}
+
+inline void move([[maybe_unused]] std::size_t count = 1)
+{
+#if defined(ALGORITHMS_INSTRUMENTATION)
+  Detail::ThreadCounters::add(Detail::thread_counters().moves, count);
+#endif
+}
+
+inline void step([[maybe_unused]] std::size_t count = 1)
+{
+#if defined(ALGORITHMS_INSTRUMENTATION)
+  Detail::ThreadCounters::add(Detail::thread_counters().steps, count);
+#endif
+}
+
+// lhs < rhs, counted as one comparison
+template <class Lhs, class Rhs>
+bool less(const Lhs& lhs, const Rhs& rhs)
+{
+  comparison();
+  return lhs < rhs;
+}
+
+// std::allocator that reports every allocation it makes with its exact
+// size, e.g. for std::allocate_shared where the control block is hidden
+template <class T>
+struct CountingAllocator
+{
+  using value_type = T;
+
+  CountingAllocator() = default;
+
+  template <class U>
+  CountingAllocator(const CountingAllocator<U>&) { }
+
+  T* allocate(std::size_t n)
+  {
+    allocation(n * sizeof(T));
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n) { std::allocator<T>().deallocate(p, n); }
+
+  template <class U>
+  bool operator== (const CountingAllocator<U>&) const { return true; }
+
+  template <class U>
+  bool operator!= (const CountingAllocator<U>&) const { return false; }
+};
+
+// One level of recursion for as long as it lives
+class Depth
+{
+public:
+#if defined(ALGORITHMS_INSTRUMENTATION)
+  Depth()
+  {
+    auto& counters = Detail::thread_counters();
+
+    if (++counters.depth > counters.max_depth.load(std::memory_order_relaxed))
+      counters.max_depth.store(counters.depth, std::memory_order_relaxed);
+  }
+
+  ~Depth() { --Detail::thread_counters().depth; }
+#else
+  Depth() { }
+#endif
+
+  Depth(const Depth&) = delete;
+  Depth& operator= (const Depth&) = delete;
+};
+
+} // namespace Instrument
+
+} // namespace Utility
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef> // size_t
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "range_adaptors.hpp"
+#include "thread_pool.hpp"
+
+namespace Utility::Detail {
+
+constexpr std::size_t cache_line = 64;
+
+template <class Iterator>
+struct ParallelChunk
+{
+  Iterator first;
+  Iterator last;
+  std::size_t index; // position of first in the whole range
+  std::size_t size;
+};
+
+// Chunk length: a few chunks per worker, rounded up to whole cache lines
+template <class Value>
+std::size_t grain(std::size_t count, std::size_t workers)
+{
+  const auto per_line = std::max<std::size_t>(cache_line / sizeof(Value), 1);
+  const auto chunks = workers * 4;
+  const auto length = (count + chunks - 1) / chunks;
+
+  return std::max<std::size_t>((length + per_line - 1) / per_line * per_line, per_line);
+}
+
+// Iterators known to walk contiguous memory: pointers and those of std::vector
+template <class Iterator, class Value = typename std::iterator_traits<Iterator>::value_type>
+constexpr bool is_contiguous_v = std::is_pointer_v<Iterator>
+  || std::is_same_v<Iterator, typename std::vector<Value>::iterator>
+  || std::is_same_v<Iterator, typename std::vector<Value>::const_iterator>;
+
+// Elements before the first one on a cache line boundary, 0 if the elements
+// cannot line up with cache lines at all
+template <class Iterator>
+std::size_t cache_head(Iterator first, std::size_t count)
+{
+  using Value = typename std::iterator_traits<Iterator>::value_type;
+
+  if constexpr (is_contiguous_v<Iterator>) {
+    if (count == 0 || cache_line % sizeof(Value) != 0)
+      return 0;
+
+    const auto address = reinterpret_cast<std::uintptr_t>(std::addressof(*first));
+
+    if (address % sizeof(Value) != 0)
+      return 0;
+
+    return std::min((cache_line - address % cache_line) % cache_line / sizeof(Value), count);
+  } else {
+    return 0;
+  }
+}
+
+/*
+  Random access views are cut every grain elements. Over contiguous memory
+  the cuts are put on cache line boundaries, the first chunk also takes the
+  elements before the first boundary, so no two chunks share a line.
+*/
+template <class View>
+auto split(const View& view, std::size_t workers)
+{
+  using Iterator = decltype(view.begin());
+  using Value = std::decay_t<decltype(*std::declval<Iterator&>())>;
+
+  std::vector<ParallelChunk<Iterator>> chunks;
+
+  if constexpr (is_random_access<Iterator>::value) {
+    const auto first = view.begin();
+    const auto count = static_cast<std::size_t>(view.end() - first);
+    const auto length = grain<Value>(count, workers);
+
+    for (std::size_t i = 0, last = cache_head(first, count); i < count; i = last) {
+      last = std::min(last + length, count);
+      chunks.push_back({first + i, first + last, i, last - i});
+    }
+  } else {
+    // forward only: one walk to count, one walk to cut
+    std::size_t count = 0;
+    for (auto it = view.begin(); it != view.end(); ++it)
+      ++count;
+
+    const auto length = grain<Value>(count, workers);
+
+    auto it = view.begin();
+    for (std::size_t i = 0; i < count; i += length) {
+      const auto last = std::min(i + length, count);
+
+      auto first = it;
+      for (std::size_t j = i; j < last; ++j)
+        ++it;
+      chunks.push_back({first, it, i, last - i});
+    }
+  }
+
+  return chunks;
+}
+
+} // namespace Utility::Detail
+
+namespace Utility {
+
+template <class Range, class Func>
+void for_each(Range&& range, Func f, ThreadPool& pool = ThreadPool::shared())
+{
+  const auto view = Detail::all(std::forward<Range>(range));
+  const auto chunks = Detail::split(view, pool.size());
+
+  TaskGroup group(pool);
+
+  for (const auto& chunk : chunks) {
+    group.run([chunk, &f] {
+      for (auto it = chunk.first; it != chunk.last; ++it)
+        f(*it);
+    });
+  }
+
+  group.wait();
+}
+
+
+// f(0) ... f(count - 1), every call a task of its own
+template <class Func>
+void for_each_index(std::size_t count, Func f, ThreadPool& pool = ThreadPool::shared())
+{
+  TaskGroup group(pool);
+
+  for (std::size_t i = 0; i < count; ++i)
+    group.run([i, &f] { f(i); });
+
+  group.wait();
+}
+
+
+template <class Range, class T, class Reduce, class Transform>
+T transform_reduce(Range&& range, T init, Reduce reduce, Transform transform,
+                   ThreadPool& pool = ThreadPool::shared())
+{
+  const auto view = Detail::all(std::forward<Range>(range));
+  const auto chunks = Detail::split(view, pool.size());
+
+  std::vector<std::optional<T>> partial(chunks.size());
+
+  TaskGroup group(pool);
+
+  for (std::size_t i = 0; i < chunks.size(); ++i) {
+    group.run([chunk = chunks[i], &result = partial[i], &reduce, &transform] {
+      auto it = chunk.first;
+      T value = transform(*it);
+
+      for (++it; it != chunk.last; ++it)
+        value = reduce(value, transform(*it));
+
+      result = value;
+    });
+  }
+
+  group.wait();
+
+  for (const auto& value : partial)
+    init = reduce(init, *value);
+
+  return init;
+}
+
+
+// out must be random access, every chunk writes its own slice of it
+template <class Range, class OutputIt, class BinaryOp>
+OutputIt inclusive_scan(Range&& range, OutputIt out, BinaryOp op,
+                        ThreadPool& pool = ThreadPool::shared())
+{
+  const auto view = Detail::all(std::forward<Range>(range));
+  const auto chunks = Detail::split(view, pool.size());
+
+  using Iterator = decltype(view.begin());
+  using T = std::decay_t<decltype(*std::declval<Iterator&>())>;
+
+  if (chunks.empty())
+    return out;
+
+  // pass 1: total of every chunk
+  std::vector<std::optional<T>> totals(chunks.size());
+
+  TaskGroup group(pool);
+
+  for (std::size_t i = 1; i < chunks.size(); ++i) {
+    group.run([chunk = chunks[i - 1], &total = totals[i - 1], &op] {
+      auto it = chunk.first;
+      T value = *it;
+
+      for (++it; it != chunk.last; ++it)
+        value = op(value, *it);
+
+      total = value;
+    });
+  }
+
+  group.wait();
+
+  // carry into every chunk, the first one has none
+  for (std::size_t i = 1; i + 1 < chunks.size(); ++i)
+    totals[i] = op(*totals[i - 1], *totals[i]);
+
+  // pass 2: scan of every chunk seeded with its carry
+  for (std::size_t i = 0; i < chunks.size(); ++i) {
+    const auto carry = i == 0 ? std::nullopt : totals[i - 1];
+
+    group.run([chunk = chunks[i], carry, out, &op] {
+      auto it = chunk.first;
+      auto dest = out + chunk.index;
+
+      T value = carry ? op(*carry, *it) : T(*it);
+      *dest = value;
+
+      for (++it, ++dest; it != chunk.last; ++it, ++dest) {
+        value = op(value, *it);
+        *dest = value;
+      }
+    });
+  }
+
+  group.wait();
+
+  return out + (chunks.back().index + chunks.back().size);
+}
+
+} // namespace Utility
@@ -0,0 +1,408 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef> // size_t
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "range_offset.hpp"
+
+namespace Utility {
+
+/*
+  ADAPTOR TAGS
+*/
+struct Take { std::size_t count = 0; };
+struct Stride { std::size_t step = 1; };
+struct Chunk { std::size_t size = 1; };
+struct Enumerate { };
+
+template <class Predicate> struct Filter { Predicate predicate; };
+template <class Func> struct Transform { Func func; };
+template <class Other> struct Zip { Other other; };
+
+constexpr Take take(std::size_t count) { return {count}; }
+
+// a step or size of 0 would never move on
+constexpr Stride stride(std::size_t step)
+{
+  assert(step > 0);
+  return {step};
+}
+
+constexpr Chunk chunk(std::size_t size)
+{
+  assert(size > 0);
+  return {size};
+}
+
+constexpr Enumerate enumerate() { return {}; }
+
+template <class Predicate>
+constexpr Filter<Predicate> filter(Predicate p) { return {p}; }
+
+template <class Func>
+constexpr Transform<Func> transform(Func f) { return {f}; }
+
+template <class Range>
+constexpr auto zip(Range&& range)
+{
+  return Zip<Detail::AllView<Range>>{Detail::all(std::forward<Range>(range))};
+}
+
+
+/*
+  ITERATORS
+  Every iterator carries what it needs to advance (end, step, functor),
+  so a view can be a temporary inside a pipeline.
+*/
+template <class Iterator>
+class TakeIterator
+{
+  Iterator it_;
+  std::size_t count_;
+
+public:
+  constexpr TakeIterator(Iterator it, std::size_t count)
+    : it_{it}, count_{count}
+  { }
+
+  constexpr bool operator!= (const TakeIterator& other) const
+  {
+    return count_ != other.count_ && it_ != other.it_;
+  }
+
+  constexpr decltype(auto) operator* () { return *it_; }
+
+  constexpr TakeIterator& operator++ ()
+  {
+    ++it_;
+    --count_;
+    return *this;
+  }
+};
+
+template <class Iterator>
+class StrideIterator
+{
+  Iterator it_;
+  Iterator end_;
+  std::size_t step_;
+
+public:
+  constexpr StrideIterator(Iterator it, Iterator end, std::size_t step)
+    : it_{it}, end_{end}, step_{step}
+  { }
+
+  constexpr bool operator!= (const StrideIterator& other) const { return it_ != other.it_; }
+
+  constexpr decltype(auto) operator* () { return *it_; }
+
+  constexpr StrideIterator& operator++ ()
+  {
+    for (std::size_t i = 0; i < step_ && it_ != end_; ++i)
+      ++it_;
+    return *this;
+  }
+};
+
+template <class Iterator, class Predicate>
+class FilterIterator
+{
+  Iterator it_;
+  Iterator end_;
+  Predicate predicate_;
+
+  constexpr void satisfy()
+  {
+    while (it_ != end_ && !predicate_(*it_))
+      ++it_;
+  }
+
+public:
+  constexpr FilterIterator(Iterator it, Iterator end, Predicate p)
+    : it_{it}, end_{end}, predicate_{p}
+  {
+    satisfy();
+  }
+
+  constexpr bool operator!= (const FilterIterator& other) const { return it_ != other.it_; }
+
+  constexpr decltype(auto) operator* () { return *it_; }
+
+  constexpr FilterIterator& operator++ ()
+  {
+    ++it_;
+    satisfy();
+    return *this;
+  }
+};
+
+template <class Iterator, class Func>
+class TransformIterator
+{
+  Iterator it_;
+  Func func_;
+
+public:
+  constexpr TransformIterator(Iterator it, Func f)
+    : it_{it}, func_{f}
+  { }
+
+  constexpr bool operator!= (const TransformIterator& other) const { return it_ != other.it_; }
+
+  constexpr decltype(auto) operator* () { return func_(*it_); }
+
+  constexpr TransformIterator& operator++ ()
+  {
+    ++it_;
+    return *this;
+  }
+};
+
+template <class Iterator>
+class ChunkIterator
+{
+  Iterator it_;
+  Iterator next_;
+  Iterator end_;
+  std::size_t size_;
+
+  constexpr void find_next()
+  {
+    next_ = it_;
+    for (std::size_t i = 0; i < size_ && next_ != end_; ++i)
+      ++next_;
+  }
+
+public:
+  constexpr ChunkIterator(Iterator it, Iterator end, std::size_t size)
+    : it_{it}, next_{it}, end_{end}, size_{size}
+  {
+    find_next();
+  }
+
+  constexpr bool operator!= (const ChunkIterator& other) const { return it_ != other.it_; }
+
+  constexpr auto operator* () const { return View{it_, next_}; }
+
+  constexpr ChunkIterator& operator++ ()
+  {
+    it_ = next_;
+    find_next();
+    return *this;
+  }
+};
+
+template <class First, class Second>
+class ZipIterator
+{
+  First first_;
+  Second second_;
+
+public:
+  constexpr ZipIterator(First first, Second second)
+    : first_{first}, second_{second}
+  { }
+
+  // stops as soon as the shorter range is exhausted
+  constexpr bool operator!= (const ZipIterator& other) const
+  {
+    return first_ != other.first_ && second_ != other.second_;
+  }
+
+  constexpr auto operator* ()
+  {
+    return std::pair<decltype(*first_), decltype(*second_)>{*first_, *second_};
+  }
+
+  constexpr ZipIterator& operator++ ()
+  {
+    ++first_;
+    ++second_;
+    return *this;
+  }
+};
+
+template <class Iterator>
+class EnumerateIterator
+{
+  Iterator it_;
+  std::size_t index_;
+
+public:
+  constexpr EnumerateIterator(Iterator it, std::size_t index)
+    : it_{it}, index_{index}
+  { }
+
+  constexpr bool operator!= (const EnumerateIterator& other) const { return it_ != other.it_; }
+
+  constexpr auto operator* ()
+  {
+    return std::pair<std::size_t, decltype(*it_)>{index_, *it_};
+  }
+
+  constexpr EnumerateIterator& operator++ ()
+  {
+    ++it_;
+    ++index_;
+    return *this;
+  }
+};
+
+
+/*
+  VIEWS
+*/
+template <class Base>
+class TakeView : public ViewBase
+{
+  Base base_;
+  std::size_t count_;
+
+public:
+  constexpr TakeView(Base base, std::size_t count)
+    : base_{std::move(base)}, count_{count}
+  { }
+
+  constexpr auto begin() const { return TakeIterator{base_.begin(), count_}; }
+  constexpr auto end() const { return TakeIterator{base_.end(), std::size_t{0}}; }
+};
+
+template <class Base>
+class StrideView : public ViewBase
+{
+  Base base_;
+  std::size_t step_;
+
+public:
+  constexpr StrideView(Base base, std::size_t step)
+    : base_{std::move(base)}, step_{step}
+  { }
+
+  constexpr auto begin() const { return StrideIterator{base_.begin(), base_.end(), step_}; }
+  constexpr auto end() const { return StrideIterator{base_.end(), base_.end(), step_}; }
+};
+
+template <class Base, class Predicate>
+class FilterView : public ViewBase
+{
+  Base base_;
+  Predicate predicate_;
+
+public:
+  constexpr FilterView(Base base, Predicate p)
+    : base_{std::move(base)}, predicate_{p}
+  { }
+
+  constexpr auto begin() const { return FilterIterator{base_.begin(), base_.end(), predicate_}; }
+  constexpr auto end() const { return FilterIterator{base_.end(), base_.end(), predicate_}; }
+};
+
+template <class Base, class Func>
+class TransformView : public ViewBase
+{
+  Base base_;
+  Func func_;
+
+public:
+  constexpr TransformView(Base base, Func f)
+    : base_{std::move(base)}, func_{f}
+  { }
+
+  constexpr auto begin() const { return TransformIterator{base_.begin(), func_}; }
+  constexpr auto end() const { return TransformIterator{base_.end(), func_}; }
+};
+
+template <class Base>
+class ChunkView : public ViewBase
+{
+  Base base_;
+  std::size_t size_;
+
+public:
+  constexpr ChunkView(Base base, std::size_t size)
+    : base_{std::move(base)}, size_{size}
+  { }
+
+  constexpr auto begin() const { return ChunkIterator{base_.begin(), base_.end(), size_}; }
+  constexpr auto end() const { return ChunkIterator{base_.end(), base_.end(), size_}; }
+};
+
+template <class First, class Second>
+class ZipView : public ViewBase
+{
+  First first_;
+  Second second_;
+
+public:
+  constexpr ZipView(First first, Second second)
+    : first_{std::move(first)}, second_{std::move(second)}
+  { }
+
+  constexpr auto begin() const { return ZipIterator{first_.begin(), second_.begin()}; }
+  constexpr auto end() const { return ZipIterator{first_.end(), second_.end()}; }
+};
+
+template <class Base>
+class EnumerateView : public ViewBase
+{
+  Base base_;
+
+public:
+  constexpr explicit EnumerateView(Base base)
+    : base_{std::move(base)}
+  { }
+
+  constexpr auto begin() const { return EnumerateIterator{base_.begin(), std::size_t{0}}; }
+  constexpr auto end() const { return EnumerateIterator{base_.end(), std::size_t{0}}; }
+};
+
+
+/*
+  PIPES
+*/
+template <class Range>
+constexpr auto operator| (Range&& range, Take t)
+{
+  return TakeView{Detail::all(std::forward<Range>(range)), t.count};
+}
+
+template <class Range>
+constexpr auto operator| (Range&& range, Stride s)
+{
+  return StrideView{Detail::all(std::forward<Range>(range)), s.step};
+}
+
+template <class Range, class Predicate>
+constexpr auto operator| (Range&& range, Filter<Predicate> f)
+{
+  return FilterView{Detail::all(std::forward<Range>(range)), f.predicate};
+}
+
+template <class Range, class Func>
+constexpr auto operator| (Range&& range, Transform<Func> t)
+{
+  return TransformView{Detail::all(std::forward<Range>(range)), t.func};
+}
+
+template <class Range>
+constexpr auto operator| (Range&& range, Chunk c)
+{
+  return ChunkView{Detail::all(std::forward<Range>(range)), c.size};
+}
+
+template <class Range, class Other>
+constexpr auto operator| (Range&& range, Zip<Other> z)
+{
+  return ZipView{Detail::all(std::forward<Range>(range)), std::move(z.other)};
+}
+
+template <class Range>
+constexpr auto operator| (Range&& range, Enumerate)
+{
+  return EnumerateView{Detail::all(std::forward<Range>(range))};
+}
+
+} // namespace Utility
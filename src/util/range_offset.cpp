@@ -1,11 +0,0 @@
-#include "range_offset.hpp"
-
-namespace Utility
-{
-
-Offset offset(std::size_t value)
-{
-  return {value};
-} 
-
-} // namespace Utility
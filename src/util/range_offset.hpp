@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef> // size_t
+#include <iterator>
+#include <type_traits>
 #include <utility>
 
 namespace Utility
@@ -10,16 +13,19 @@ struct Offset
   std::size_t offset = 0;
 };
 
-Offset offset(std::size_t value);
+constexpr Offset offset(std::size_t value) { return {value}; }
+
+// Marker of the lightweight ranges, adaptors copy them instead of referencing
+struct ViewBase { };
 
 template <class Iterator>
-class View
+class View : public ViewBase
 {
   Iterator begin_;
   Iterator end_;
 
 public:
-  explicit View(Iterator begin, Iterator end)
+  constexpr explicit View(Iterator begin, Iterator end)
     : begin_{begin}, end_{end}
   { }
 
@@ -27,13 +33,88 @@ public:
   constexpr auto end() const { return end_; }
 };
 
+// Keeps a temporary range alive for as long as the pipeline built on it
+template <class Range>
+class OwningView : public ViewBase
+{
+  Range range_;
+
+public:
+  constexpr explicit OwningView(Range&& range)
+    : range_{std::move(range)}
+  { }
+
+  constexpr auto begin() const { return std::begin(range_); }
+  constexpr auto end() const { return std::end(range_); }
+};
+
+} // namespace Utility
+
+namespace Utility::Detail {
+
+template <class Iterator, class = void>
+struct is_random_access : std::false_type { };
+
+template <class Iterator>
+struct is_random_access<Iterator, std::void_t<typename std::iterator_traits<Iterator>::iterator_category>>
+  : std::is_base_of<std::random_access_iterator_tag,
+                    typename std::iterator_traits<Iterator>::iterator_category>
+{ };
+
+// Views are copied (or moved), lvalue ranges are referenced,
+// rvalue ranges are moved into an OwningView
+template <class Range>
+constexpr auto all(Range&& range)
+{
+  if constexpr (std::is_base_of_v<ViewBase, std::decay_t<Range>>)
+    return std::decay_t<Range>(std::forward<Range>(range));
+  else if constexpr (std::is_lvalue_reference_v<Range>)
+    return View{std::begin(range), std::end(range)};
+  else
+    return OwningView<std::decay_t<Range>>{std::move(range)};
+}
+
+template <class Range>
+using AllView = decltype(all(std::declval<Range>()));
+
+// first advanced by n, but never past last
+template <class Iterator>
+constexpr Iterator advance_clamped(Iterator first, Iterator last, std::size_t n)
+{
+  if constexpr (is_random_access<Iterator>::value) {
+    const auto size = static_cast<std::size_t>(last - first);
+    return first + static_cast<std::ptrdiff_t>(n < size ? n : size);
+  } else {
+    for (std::size_t i = 0; i < n && first != last; ++i)
+      ++first;
+    return first;
+  }
+}
+
+} // namespace Utility::Detail
+
+namespace Utility
+{
+
+template <class Base>
+class OffsetView : public ViewBase
+{
+  Base base_;
+  std::size_t offset_;
+
+public:
+  constexpr OffsetView(Base base, std::size_t offset)
+    : base_{std::move(base)}, offset_{offset}
+  { }
+
+  constexpr auto begin() const { return Detail::advance_clamped(base_.begin(), base_.end(), offset_); }
+  constexpr auto end() const { return base_.end(); }
+};
+
 template <class Range>
-auto operator| (Range&& range, Offset o)
+constexpr auto operator| (Range&& range, Offset o)
 {
-  return View {
-    std::begin(std::forward<Range>(range)) + o.offset,
-    std::end(std::forward<Range>(range)),
-  };
+  return OffsetView{Detail::all(std::forward<Range>(range)), o.offset};
 }
 
 } // Utility
@@ -0,0 +1,183 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+namespace Utility
+{
+
+namespace
+{
+// Pool and queue owned by the current thread, if it is a worker
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local std::size_t current_index = 0;
+}
+
+
+ThreadPool::ThreadPool(std::size_t threads)
+  : next_queue_{0}
+  , pending_{0}
+  , stop_{false}
+{
+  threads = std::max<std::size_t>(threads, 1);
+
+  for (std::size_t i = 0; i < threads; ++i)
+    queues_.push_back(std::make_unique<Queue>());
+
+  for (std::size_t i = 0; i < threads; ++i)
+    threads_.emplace_back([this, i] { run(i); });
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard lock(sleep_mutex_);
+    stop_ = true;
+  }
+
+  wake_.notify_all();
+
+  for (auto& thread : threads_)
+    thread.join();
+}
+
+
+std::size_t ThreadPool::size() const { return threads_.size(); }
+
+
+void ThreadPool::submit(std::function<void()> task)
+{
+  const auto index = current_pool == this
+    ? current_index
+    : next_queue_++ % queues_.size();
+
+  // counted before it can be popped, so pending_ never drops below zero
+  {
+    std::lock_guard lock(sleep_mutex_);
+    ++pending_;
+  }
+
+  {
+    auto& queue = *queues_[index];
+    std::lock_guard lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+
+  wake_.notify_one();
+}
+
+bool ThreadPool::run_pending()
+{
+  std::function<void()> task;
+
+  const auto index = current_pool == this ? current_index : 0;
+
+  if (!pop(index, task))
+    return false;
+
+  task();
+  return true;
+}
+
+
+ThreadPool& ThreadPool::shared()
+{
+  static ThreadPool pool;
+  return pool;
+}
+
+
+void ThreadPool::run(std::size_t index)
+{
+  current_pool = this;
+  current_index = index;
+
+  std::function<void()> task;
+
+  while (true) {
+    if (pop(index, task)) {
+      task();
+      continue;
+    }
+
+    std::unique_lock lock(sleep_mutex_);
+    wake_.wait(lock, [this] { return stop_ || pending_ > 0; });
+
+    if (stop_ && pending_ == 0)
+      return;
+  }
+}
+
+bool ThreadPool::pop(std::size_t index, std::function<void()>& task)
+{
+  const auto count = queues_.size();
+
+  for (std::size_t i = 0; i < count; ++i) {
+    auto& queue = *queues_[(index + i) % count];
+    std::lock_guard lock(queue.mutex);
+
+    if (queue.tasks.empty())
+      continue;
+
+    // own queue works as a stack, the others are robbed from the other end
+    if (i == 0) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+
+    --pending_;
+    return true;
+  }
+
+  return false;
+}
+
+
+TaskGroup::TaskGroup(ThreadPool& pool)
+  : pool_{pool}
+  , remaining_{0}
+{ }
+
+void TaskGroup::wait()
+{
+  while (true) {
+    {
+      std::lock_guard lock(mutex_);
+      if (remaining_ == 0)
+        break;
+    }
+
+    if (pool_.run_pending())
+      continue;
+
+    std::unique_lock lock(mutex_);
+    done_.wait(lock, [this] { return remaining_ == 0; });
+    break;
+  }
+
+  // all tasks are done, the group can be used again
+  std::exception_ptr error;
+
+  {
+    std::lock_guard lock(mutex_);
+    std::swap(error, error_);
+  }
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+void TaskGroup::finish(std::exception_ptr error)
+{
+  std::lock_guard lock(mutex_);
+
+  if (error && !error_)
+    error_ = error;
+
+  if (--remaining_ == 0)
+    done_.notify_all();
+}
+
+} // namespace Utility
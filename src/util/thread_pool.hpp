@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef> // size_t
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Utility {
+
+// Fixed set of workers, each with its own task deque. A worker pops from the
+// back of its deque and steals from the front of the others when idle.
+class ThreadPool
+{
+public:
+  explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency());
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator= (const ThreadPool&) = delete;
+
+  std::size_t size() const;
+
+  void submit(std::function<void()> task);
+
+  // Runs one queued task on the calling thread, if there is any
+  bool run_pending();
+
+  static ThreadPool& shared();
+
+private:
+  struct Queue
+  {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> threads_;
+
+  std::atomic<std::size_t> next_queue_;
+  std::atomic<std::size_t> pending_;
+
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  bool stop_;
+
+  void run(std::size_t index);
+
+  bool pop(std::size_t index, std::function<void()>& task);
+};
+
+
+// Counts down finished tasks, waiting threads help the pool meanwhile.
+// The first exception thrown by a task is rethrown by wait().
+class TaskGroup
+{
+public:
+  explicit TaskGroup(ThreadPool& pool);
+
+  template <class Func>
+  void run(Func f);
+
+  void wait();
+
+private:
+  ThreadPool& pool_;
+
+  std::mutex mutex_;
+  std::condition_variable done_;
+  std::size_t remaining_;
+  std::exception_ptr error_;
+
+  void finish(std::exception_ptr error);
+};
+
+
+template <class Func>
+void TaskGroup::run(Func f)
+{
+  {
+    std::lock_guard lock(mutex_);
+    ++remaining_;
+  }
+
+  pool_.submit([this, f]() mutable {
+    std::exception_ptr error;
+
+    try {
+      f();
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    finish(error);
+  });
+}
+
+} // namespace Utility
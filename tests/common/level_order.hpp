@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef> // size_t
+#include <utility>
+#include <vector>
+
+namespace Testing {
+
+/*
+  Inserts value(0) ... value(size - 1), given in ascending order, so that a
+  binary search tree comes out complete: the middle first, then the middles
+  of both halves, level by level.
+*/
+template <class Tree, class Value>
+void insert_level_order(Tree& tree, std::size_t size, Value value)
+{
+  std::vector<std::pair<std::size_t, std::size_t>> ranges{{0, size}};
+
+  for (std::size_t i = 0; i < ranges.size(); ++i) {
+    const auto [lo, hi] = ranges[i];
+    if (lo == hi)
+      continue;
+
+    const auto mid = lo + (hi - lo) / 2;
+    tree.insert(value(mid));
+    ranges.push_back({lo, mid});
+    ranges.push_back({mid + 1, hi});
+  }
+}
+
+} // namespace Testing
@@ -1,9 +1,23 @@
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
 #include "clist.hpp"
 
 using namespace Container;
 
+template <class T>
+std::vector<T> to_vector(CList<T>& clist)
+{
+  std::vector<T> result;
+  for (auto it = clist.begin(); it != clist.end(); ++it)
+    result.push_back(*it);
+  return result;
+}
+
 BOOST_AUTO_TEST_CASE(container_clist_size) // 1
 {
   CList<int> clist;
@@ -99,3 +113,81 @@ BOOST_AUTO_TEST_CASE(container_clist_insert_erase) // 7
   clist.erase(it);
   BOOST_CHECK(clist[1] == 3);
 }
+
+BOOST_AUTO_TEST_CASE(container_clist_sort) // 8
+{
+  CList<std::pair<int, int>> clist;
+
+  std::vector<std::pair<int, int>> expected;
+
+  std::srand(3);
+  for (int i = 0; i < 1000; ++i) {
+    clist.push_back({std::rand() % 50, i});
+    expected.push_back(clist.back());
+  }
+
+  const auto by_key = [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; };
+
+  // nodes keep their addresses, only the links change
+  const auto* first_value = &clist.front();
+
+  clist.sort(by_key);
+  std::stable_sort(expected.begin(), expected.end(), by_key);
+
+  BOOST_CHECK(to_vector(clist) == expected);
+  BOOST_CHECK(clist.size() == 1000);
+
+  std::vector<std::pair<int, int>> backward;
+  for (auto it = clist.end() - 1; it != clist.end(); --it)
+    backward.push_back(*it);
+
+  BOOST_CHECK(std::equal(backward.rbegin(), backward.rend(), expected.begin(), expected.end()));
+
+  bool found = false;
+  for (auto it = clist.begin(); it != clist.end(); ++it)
+    found |= &*it == first_value;
+
+  BOOST_CHECK(found);
+}
+
+BOOST_AUTO_TEST_CASE(container_clist_merge) // 9
+{
+  using Entry = std::pair<int, int>; // key, list it came from
+
+  CList<Entry> lhs;
+  CList<Entry> rhs;
+
+  for (const auto key : {1, 3, 3, 5, 7})
+    lhs.push_back({key, 0});
+
+  for (const auto key : {0, 3, 3, 8})
+    rhs.push_back({key, 1});
+
+  const auto by_key = [](const auto& a, const auto& b) { return a.first < b.first; };
+
+  lhs.merge(rhs, by_key);
+
+  // equal keys of this list stay first
+  BOOST_CHECK(to_vector(lhs) == std::vector<Entry>({
+    {0, 1}, {1, 0}, {3, 0}, {3, 0}, {3, 1}, {3, 1}, {5, 0}, {7, 0}, {8, 1}}));
+  BOOST_CHECK(lhs.size() == 9);
+  BOOST_CHECK(rhs.size() == 0);
+  BOOST_CHECK(lhs.back() == Entry(8, 1));
+
+  CList<Entry> empty;
+  empty.merge(lhs, by_key);
+
+  BOOST_CHECK(empty.size() == 9 && empty.front() == Entry(0, 1));
+
+  CList<Entry> descending;
+  descending.push_back({9, 2});
+  descending.push_back({3, 2});
+
+  const auto by_key_descending = [](const auto& a, const auto& b) { return a.first > b.first; };
+
+  empty.sort(by_key_descending);
+  empty.merge(descending, by_key_descending);
+
+  BOOST_CHECK(to_vector(empty) == std::vector<Entry>({
+    {9, 2}, {8, 1}, {7, 0}, {5, 0}, {3, 0}, {3, 0}, {3, 1}, {3, 1}, {3, 2}, {1, 0}, {0, 1}}));
+}
@@ -0,0 +1,183 @@
+#include <boost/test/unit_test.hpp>
+
+#include "compact_graph.hpp"
+#include "graph.hpp"
+
+BOOST_AUTO_TEST_CASE( compact_graph_case_1 )
+{
+  Container::CompactGraph graph;
+
+  for (const auto label : {"0", "1", "2", "3", "4"})
+    graph.add_node(label);
+
+  graph.add_adj("0", "1", 13);
+  graph.add_adj("0", "3", 7);
+
+  graph.add_adj("1", "2", 2);
+
+  graph.add_adj("2", "0", 3);
+  graph.add_adj("2", "4", 3);
+
+  graph.add_adj("3", "0", 8);
+  graph.add_adj("3", "1", 2);
+  graph.add_adj("3", "4", 9);
+
+  graph.add_adj("4", "0", 7);
+
+  BOOST_CHECK( graph.radius() == 7 );
+}
+
+
+BOOST_AUTO_TEST_CASE( compact_graph_case_2 )
+{
+  Container::CompactGraph graph;
+
+  for (const auto label : {"0", "1", "2", "3", "4", "5"})
+    graph.add_node(label);
+
+  graph.add_adj("0", "1", 7);
+  graph.add_adj("0", "2", 9);
+  graph.add_adj("0", "5", 14);
+
+  graph.add_adj("1", "0", 7);
+  graph.add_adj("1", "2", 10);
+  graph.add_adj("1", "3", 15);
+
+  graph.add_adj("2", "0", 9);
+  graph.add_adj("2", "1", 10);
+  graph.add_adj("2", "3", 11);
+  graph.add_adj("2", "5", 2);
+
+  graph.add_adj("3", "1", 15);
+  graph.add_adj("3", "2", 11);
+  graph.add_adj("3", "4", 6);
+
+  graph.add_adj("4", "3", 6);
+  graph.add_adj("4", "5", 9);
+
+  graph.add_adj("5", "0", 14);
+  graph.add_adj("5", "2", 2);
+  graph.add_adj("5", "4", 9);
+
+  BOOST_CHECK( graph.radius() == 11 );
+}
+
+
+BOOST_AUTO_TEST_CASE( compact_graph_del_node )
+{
+  Container::CompactGraph graph;
+
+  const auto a = graph.add_node("0");
+  const auto b = graph.add_node("1");
+  const auto c = graph.add_node("2");
+
+  graph.add_adj(a, b, 1);
+  graph.add_adj(a, c, 1);
+  graph.add_adj(c, b, 1);
+
+  graph.del_node("1");
+  graph.del_node("missing");
+
+  BOOST_CHECK( !graph.contains(b) );
+  BOOST_CHECK( graph.node_count() == 2 );
+
+  // surviving handles are untouched and the dead one is not reused
+  BOOST_CHECK( graph.label(c) == "2" );
+  BOOST_CHECK( graph.add_node("3") == 3 );
+
+  size_t visited = 0;
+  graph.bfs_iterate(a, [&visited](auto) { ++visited; return false; });
+
+  BOOST_CHECK( visited == 2 );
+  BOOST_CHECK( graph.csr().edge_count() == 1 );
+  BOOST_CHECK( !graph.first(c) );
+}
+
+
+BOOST_AUTO_TEST_CASE( compact_graph_edit )
+{
+  Container::CompactGraph graph;
+
+  graph.add_node("a");
+  graph.add_node("b");
+  graph.add_node("a");
+
+  graph.add_adj("a", "b", 1);
+  graph.add_adj("a", "a", 2);
+  graph.add_adj("a", "b", 3);
+
+  BOOST_CHECK( graph.adjacent(0).size() == 3 );
+  BOOST_CHECK( *graph.first(0) == 1 );
+  BOOST_CHECK( *graph.next(0, 1) == 0 );
+  BOOST_CHECK( !graph.next(0, 2) );
+
+  graph.edit_adj("a", "b", 5);
+  BOOST_CHECK( graph.adjacent(0)[0].coast == 5 && graph.adjacent(0)[2].coast == 3 );
+
+  graph.del_adj("a", "b");
+  BOOST_CHECK( graph.adjacent(0).size() == 2 && graph.adjacent(0)[1].coast == 3 );
+
+  // the label passes to the other node named "a"
+  graph.edit_node("a", "c");
+  BOOST_CHECK( *graph.find("c") == 0 );
+  BOOST_CHECK( *graph.find("a") == 2 );
+
+  graph.del_node("a");
+  BOOST_CHECK( !graph.find("a") );
+}
+
+
+BOOST_AUTO_TEST_CASE( compact_graph_csr )
+{
+  Container::Graph reference;
+
+  for (const auto label : {"0", "1", "2", "3", "4", "5"})
+    reference.add_node(label);
+
+  for (int u = 0; u < 6; ++u)
+    for (int v = 0; v < 6; ++v)
+      if ((u * 7 + v) % 3 == 0)
+        reference.add_adj(std::to_string(u), std::to_string(v), u + v);
+
+  const auto csr = reference.csr();
+  auto graph = Container::CompactGraph::from_csr(csr);
+
+  const auto back = graph.csr();
+
+  BOOST_CHECK( back.offsets == csr.offsets );
+  BOOST_CHECK( back.targets == csr.targets );
+  BOOST_CHECK( back.weights == csr.weights );
+  BOOST_CHECK( back.labels == csr.labels );
+  BOOST_CHECK( graph.radius() == reference.radius() );
+
+  graph.del_node("2");
+  BOOST_CHECK( graph.csr().node_count() == 5 );
+}
+
+
+BOOST_AUTO_TEST_CASE( compact_graph_memory )
+{
+  constexpr size_t nodes = 10000;
+  constexpr size_t degree = 8;
+
+  using Handle = Container::CompactGraph::Handle;
+
+  Container::CompactGraph graph;
+
+  for (size_t i = 0; i < nodes; ++i)
+    graph.add_node(std::to_string(i));
+
+  const auto without_edges = graph.memory_usage();
+
+  for (Handle u = 0; u < nodes; ++u)
+    for (size_t k = 1; k <= degree; ++k)
+      graph.add_adj(u, static_cast<Handle>((u + k) % nodes), 1);
+
+  const auto edge_bytes = graph.memory_usage() - without_edges;
+
+  // Graph spends a list node per edge: weak_ptr, coast and two links
+  const auto list_edge_bytes = nodes * degree * (sizeof(Container::GraphAdjacency) + 2 * sizeof(void*));
+
+  BOOST_CHECK( sizeof(Container::CompactGraph::Arc) == 8 );
+  BOOST_CHECK( 4 * edge_bytes <= list_edge_bytes );
+}
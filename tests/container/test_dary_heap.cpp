@@ -0,0 +1,59 @@
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+
+#include "dary_heap.hpp"
+
+using namespace Container;
+
+BOOST_AUTO_TEST_CASE(container_dary_heap_construct) // 1
+{
+  DaryHeap<int> heap;
+
+  BOOST_CHECK(heap.empty());
+  BOOST_CHECK(heap.size() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(container_dary_heap_push_pop) // 2
+{
+  DaryHeap<int, 3> heap;
+
+  heap.push(5);
+  heap.push(2);
+  heap.push(8);
+  heap.push(1);
+
+  BOOST_CHECK(heap.size() == 4);
+  BOOST_CHECK(heap.top() == 1);
+
+  heap.pop();
+  BOOST_CHECK(heap.top() == 2);
+
+  heap.clear();
+  BOOST_CHECK(heap.empty());
+}
+
+BOOST_AUTO_TEST_CASE(container_dary_heap_order) // 3
+{
+  DaryHeap<int, 8, std::greater<int>> heap;
+  std::vector<int> values;
+
+  std::srand(26);
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(std::rand() % 100);
+    heap.push(values.back());
+  }
+
+  std::sort(values.begin(), values.end(), std::greater<int>());
+
+  std::vector<int> result;
+  while (!heap.empty()) {
+    result.push_back(heap.top());
+    heap.pop();
+  }
+
+  BOOST_CHECK(result == values);
+}
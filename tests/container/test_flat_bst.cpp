@@ -1,8 +1,12 @@
 #include <boost/test/unit_test.hpp>
 
+#include <iterator>
+#include <random>
 #include <sstream>
+#include <vector>
 
 #include "flat_bst.hpp"
+#include "level_order.hpp"
 
 using namespace Container;
 
@@ -85,3 +89,52 @@ BOOST_AUTO_TEST_CASE(container_flat_bst_iterate)
   BOOST_CHECK(ss.str() == "2436875");
 
 }
+
+BOOST_AUTO_TEST_CASE(container_flat_bst_contains)
+{
+  FlatBst<int> fb;
+
+  BOOST_CHECK(!fb.contains(5));
+
+  fb.insert({5, 3, 7, 2, 4, 6, 8});
+
+  for (int i = 2; i <= 8; ++i)
+    BOOST_CHECK(fb.contains(i));
+
+  BOOST_CHECK(!fb.contains(1));
+  BOOST_CHECK(!fb.contains(9));
+}
+
+BOOST_AUTO_TEST_CASE(container_flat_bst_find_many)
+{
+  FlatBst<int> fb;
+
+  // even values in level order, a complete tree of 1023 nodes
+  Testing::insert_level_order(fb, 1023, [](size_t i) { return int(i * 2); });
+
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> dist(-10, 2100);
+
+  std::vector<int> keys(5000);
+  for (auto& key : keys)
+    key = dist(gen);
+
+  std::vector<bool> expected;
+  for (const auto key : keys)
+    expected.push_back(fb.contains(key));
+
+  for (const size_t group : {1, 3, 16, 64, 1000}) {
+    std::vector<bool> found;
+    fb.find_many(keys.begin(), keys.end(), std::back_inserter(found), group);
+
+    BOOST_CHECK(found == expected);
+  }
+
+  std::vector<bool> found;
+  fb.find_many(keys.begin(), keys.begin(), std::back_inserter(found));
+  BOOST_CHECK(found.empty());
+
+  FlatBst<int> empty;
+  empty.find_many(keys.begin(), keys.begin() + 10, std::back_inserter(found));
+  BOOST_CHECK(found == std::vector<bool>(10, false));
+}
@@ -0,0 +1,92 @@
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+#include <vector>
+#include <string>
+
+#include "flat_btree.hpp"
+
+using namespace Container;
+
+BOOST_AUTO_TEST_CASE(container_flat_btree_construct) // 1
+{
+  FlatBtree<int> fb;
+
+  unsigned int count = 0;
+
+  const auto counter = [&count](const auto&) {
+    ++count;
+  };
+
+  fb.lnr_iterate(counter);
+
+  BOOST_CHECK(count == 0);
+  BOOST_CHECK(fb.empty());
+  BOOST_CHECK(!fb.contains(1));
+  BOOST_CHECK(!fb.lower_bound(1));
+}
+
+BOOST_AUTO_TEST_CASE(container_flat_btree_bulk_load) // 2
+{
+  FlatBtree<int> fb{5, 3, 7, 2, 4, 6, 8, 5, 3};
+
+  std::stringstream ss;
+
+  fb.lnr_iterate([&ss](const auto& value) { ss << value; });
+
+  BOOST_CHECK(fb.size() == 7);
+  BOOST_CHECK(ss.str() == "2345678");
+}
+
+BOOST_AUTO_TEST_CASE(container_flat_btree_lookup) // 3
+{
+  std::vector<int> values;
+  for (int i = 0; i < 10000; ++i)
+    values.push_back(i * 3);
+
+  const FlatBtree<int> fb(values.rbegin(), values.rend());
+
+  BOOST_CHECK(fb.size() == values.size());
+
+  bool ok = true;
+  for (int i = -1; i < 30002; ++i) {
+    ok = ok && fb.contains(i) == (i >= 0 && i % 3 == 0 && i < 30000);
+
+    const auto lb = fb.lower_bound(i);
+    if (i <= 29997)
+      ok = ok && lb && *lb == (i < 0 ? 0 : (i + 2) / 3 * 3);
+    else
+      ok = ok && !lb;
+  }
+
+  BOOST_CHECK(ok);
+}
+
+BOOST_AUTO_TEST_CASE(container_flat_btree_range) // 4
+{
+  FlatBtree<int> fb;
+
+  std::vector<int> values;
+  for (int i = 0; i < 1000; ++i)
+    values.push_back(i);
+
+  fb.assign(values.begin(), values.end());
+
+  std::vector<int> result;
+  fb.range_iterate(95, 104, [&result](const auto& value) { result.push_back(value); });
+
+  BOOST_CHECK(result == std::vector<int>({95, 96, 97, 98, 99, 100, 101, 102, 103, 104}));
+}
+
+BOOST_AUTO_TEST_CASE(container_flat_btree_generic_key) // 5
+{
+  FlatBtree<std::string, 128> fb{"pear", "apple", "plum", "fig", "kiwi", "lime"};
+
+  std::stringstream ss;
+  fb.lnr_iterate([&ss](const auto& value) { ss << value << " "; });
+
+  BOOST_CHECK(ss.str() == "apple fig kiwi lime pear plum ");
+  BOOST_CHECK(fb.contains("kiwi"));
+  BOOST_CHECK(!fb.contains("grape"));
+  BOOST_CHECK(fb.lower_bound("grape") == std::string("kiwi"));
+}
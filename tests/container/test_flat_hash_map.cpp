@@ -0,0 +1,129 @@
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <cstdlib>
+
+#include "flat_hash_map.hpp"
+
+using namespace Container;
+
+BOOST_AUTO_TEST_CASE(container_flat_hash_map_basic) // 1
+{
+  FlatHashMap<int, int> map;
+
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK(map.capacity() == 0);
+  BOOST_CHECK(map.find(3) == map.end());
+
+  map[3] = 30;
+  map[4] = 40;
+
+  BOOST_CHECK(map.size() == 2);
+  BOOST_CHECK(map.find(3)->second == 30);
+  BOOST_CHECK(!map.try_emplace(3, 33).second);
+  BOOST_CHECK(map[3] == 30);
+  BOOST_CHECK(map.insert({5, 50}).second);
+
+  BOOST_CHECK(map.erase(4) == 1);
+  BOOST_CHECK(map.erase(4) == 0);
+  BOOST_CHECK(!map.contains(4));
+
+  map.erase(map.find(5));
+  BOOST_CHECK(map.size() == 1);
+  BOOST_CHECK(map.begin()->first == 3);
+}
+
+BOOST_AUTO_TEST_CASE(container_flat_hash_map_random) // 2
+{
+  FlatHashMap<int, int> map;
+  std::map<int, int> reference;
+
+  std::srand(7);
+  for (int i = 0; i < 20000; ++i) {
+    const auto key = std::rand() % 2000;
+
+    if (std::rand() % 3 == 0) {
+      BOOST_REQUIRE(map.erase(key) == reference.erase(key));
+    } else {
+      map[key] += i;
+      reference[key] += i;
+    }
+  }
+
+  BOOST_CHECK(map.size() == reference.size());
+
+  size_t visited = 0;
+  for (const auto& [key, value] : map) {
+    BOOST_REQUIRE(reference.at(key) == value);
+    ++visited;
+  }
+
+  BOOST_CHECK(visited == reference.size());
+}
+
+BOOST_AUTO_TEST_CASE(container_flat_hash_map_string_view) // 3
+{
+  FlatHashMap<std::string, size_t> map;
+
+  for (size_t i = 0; i < 100; ++i)
+    map.try_emplace("node" + std::to_string(i), i);
+
+  const std::string_view key = "node42";
+
+  BOOST_CHECK(map.find(key)->second == 42);
+  BOOST_CHECK(map.contains("node7"));
+  BOOST_CHECK(!map.contains(std::string_view("node100")));
+  BOOST_CHECK(map.erase(key) == 1);
+  BOOST_CHECK(map.size() == 99);
+}
+
+BOOST_AUTO_TEST_CASE(container_flat_hash_map_clear_keeps_storage) // 4
+{
+  FlatHashSet<std::string> set;
+
+  set.reserve(1000);
+  const auto capacity = set.capacity();
+
+  for (int i = 0; i < 1000; ++i)
+    set.insert(std::to_string(i));
+
+  BOOST_CHECK(set.capacity() == capacity);
+
+  set.clear();
+  BOOST_CHECK(set.empty());
+  BOOST_CHECK(set.capacity() == capacity);
+  BOOST_CHECK(!set.contains("5"));
+
+  // a churn of insert and erase reuses tombstones instead of growing
+  for (int i = 0; i < 100000; ++i) {
+    set.insert(std::to_string(i));
+    set.erase(std::to_string(i - 500));
+  }
+
+  BOOST_CHECK(set.size() == 500);
+  BOOST_CHECK(set.capacity() == capacity);
+}
+
+BOOST_AUTO_TEST_CASE(container_flat_hash_set_copy_move) // 5
+{
+  FlatHashSet<std::string> set;
+
+  for (int i = 0; i < 50; ++i)
+    set.insert(std::to_string(i));
+
+  auto copy = set;
+  const auto moved = std::move(set);
+
+  BOOST_CHECK(copy.size() == 50 && moved.size() == 50);
+  BOOST_CHECK(set.empty());
+
+  copy.erase("3");
+  BOOST_CHECK(!copy.contains("3") && moved.contains("3"));
+
+  set = copy;
+  BOOST_CHECK(set.size() == 49);
+  BOOST_CHECK(std::set<std::string>(set.begin(), set.end()) == std::set<std::string>(copy.begin(), copy.end()));
+}
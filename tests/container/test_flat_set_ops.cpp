@@ -0,0 +1,143 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "flat_bst.hpp"
+#include "flat_btree.hpp"
+#include "flat_rbst.hpp"
+#include "flat_set_ops.hpp"
+#include "level_order.hpp"
+
+using namespace Container;
+
+namespace
+{
+
+// Complete tree of the values, inserted in level order
+template <class Tree>
+void insert_balanced(Tree& tree, const std::vector<int>& sorted)
+{
+  Testing::insert_level_order(tree, sorted.size(), [&sorted](size_t i) { return sorted[i]; });
+}
+
+template <class Tree>
+std::vector<int> to_vector(const Tree& tree)
+{
+  return std::vector<int>(tree.begin(), tree.end());
+}
+
+std::vector<int> random_set(size_t size, int range, unsigned seed)
+{
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(0, range);
+
+  std::vector<int> values(size);
+  for (auto& value : values)
+    value = dist(gen);
+
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+
+  return values;
+}
+
+template <class Lhs, class Rhs>
+void check_all(const Lhs& lhs, const Rhs& rhs, size_t threads)
+{
+  const auto a = to_vector(lhs);
+  const auto b = to_vector(rhs);
+
+  std::vector<int> expected;
+
+  std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+  BOOST_CHECK(to_vector(set_union(lhs, rhs, threads)) == expected);
+
+  expected.clear();
+  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+  BOOST_CHECK(to_vector(set_intersection(lhs, rhs, threads)) == expected);
+
+  expected.clear();
+  std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+  BOOST_CHECK(to_vector(set_difference(lhs, rhs, threads)) == expected);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(container_flat_tree_iterators)
+{
+  FlatBst<int> bst;
+  FlatRbst<int> rbst;
+
+  BOOST_CHECK(bst.begin() == bst.end());
+  BOOST_CHECK(rbst.begin() == rbst.end());
+
+  const auto values = random_set(200, 1000, 1);
+
+  for (auto it = values.rbegin(); it != values.rend(); ++it)
+    rbst.insert(*it);
+  insert_balanced(bst, values);
+
+  BOOST_CHECK(bst.size() == values.size());
+  BOOST_CHECK(rbst.size() == values.size());
+  BOOST_CHECK(to_vector(bst) == values);
+  BOOST_CHECK(to_vector(rbst) == values);
+
+  for (int value = -1; value <= 1001; ++value) {
+    const auto expected = std::lower_bound(values.begin(), values.end(), value);
+
+    const auto found = bst.lower_bound(value);
+    BOOST_CHECK(expected == values.end() ? found == bst.end() : *found == *expected);
+
+    const auto rfound = rbst.lower_bound(value);
+    BOOST_CHECK(expected == values.end() ? rfound == rbst.end() : *rfound == *expected);
+  }
+
+  const auto keys = bst.splitters(8);
+  BOOST_CHECK(keys.size() == 7);
+  BOOST_CHECK(std::is_sorted(keys.begin(), keys.end()));
+}
+
+BOOST_AUTO_TEST_CASE(container_flat_set_ops_mixed)
+{
+  FlatBst<int> bst;
+  FlatRbst<int> rbst;
+
+  insert_balanced(bst, random_set(300, 600, 2));
+
+  for (const auto value : random_set(150, 600, 3))
+    rbst.insert(value);
+
+  const auto values = random_set(400, 600, 4);
+  const FlatBtree<int> btree(values.begin(), values.end());
+
+  check_all(bst, rbst, 1);
+  check_all(rbst, bst, 1);
+  check_all(bst, btree, 1);
+  check_all(btree, rbst, 1);
+
+  const FlatBst<int> empty;
+  check_all(empty, btree, 1);
+  check_all(btree, empty, 1);
+}
+
+BOOST_AUTO_TEST_CASE(container_flat_set_ops_parallel)
+{
+  FlatBst<int> bst;
+  insert_balanced(bst, random_set(1 << 15, 1 << 17, 5));
+
+  const auto large = random_set(1 << 17, 1 << 18, 6);
+  const auto small = random_set(100, 1 << 18, 7);
+
+  const FlatBtree<int> btree(large.begin(), large.end());
+  const FlatBtree<int> skewed(small.begin(), small.end());
+
+  for (const size_t threads : {1, 3, 4})
+    check_all(bst, btree, threads);
+
+  check_all(skewed, btree, 4);
+  check_all(btree, skewed, 4);
+  check_all(skewed, bst, 4);
+}
@@ -1,5 +1,13 @@
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "graph.hpp"
 
 BOOST_AUTO_TEST_CASE( graph_case_1 )
@@ -67,3 +75,113 @@ BOOST_AUTO_TEST_CASE( graph_case_2 )
 
   BOOST_CHECK( graph.radius() == 11 );
 }
+
+
+BOOST_AUTO_TEST_CASE( graph_del_node )
+{
+  Container::Graph graph;
+
+  graph.add_node("0");
+  graph.add_node("1");
+  graph.add_node("2");
+
+  graph.add_adj("0", "1", 1);
+  graph.add_adj("0", "2", 1);
+  graph.add_adj("2", "1", 1);
+
+  graph.del_node("1");
+  graph.del_node("missing");
+
+  size_t visited = 0;
+  graph.bfs_iterate(0, [&visited](const auto&) { ++visited; return false; });
+
+  BOOST_CHECK( visited == 2 );
+  BOOST_CHECK( graph.csr().edge_count() == 1 );
+  BOOST_CHECK( !graph.bfs_iterate(2, [](const auto&) { return true; }) );
+}
+
+BOOST_AUTO_TEST_CASE( graph_queries_after_changes )
+{
+  const auto build = [](Container::Graph& graph, size_t nodes) {
+    for (size_t i = 0; i < nodes; ++i)
+      graph.add_node(std::to_string(i));
+
+    for (size_t i = 0; i < nodes; ++i) {
+      graph.add_adj(std::to_string(i), std::to_string((i + 1) % nodes), 1 + i % 3);
+      graph.add_adj(std::to_string(i), std::to_string((i + 3) % nodes), 4);
+    }
+  };
+
+  // queries must follow added and deleted nodes
+  Container::Graph graph;
+  build(graph, 6);
+
+  const auto before = graph.radius();
+  BOOST_CHECK( graph.csr().node_count() == 6 );
+
+  graph.add_node("extra");
+  graph.add_adj("extra", "0", 1);
+  graph.add_adj("0", "extra", 1);
+
+  Container::Graph fresh;
+  build(fresh, 6);
+  fresh.add_node("extra");
+  fresh.add_adj("extra", "0", 1);
+  fresh.add_adj("0", "extra", 1);
+
+  BOOST_CHECK( graph.radius() == fresh.radius() );
+  BOOST_CHECK( graph.csr().edge_count() == fresh.csr().edge_count() );
+
+  graph.del_node("extra");
+
+  BOOST_CHECK( graph.radius() == before );
+  BOOST_CHECK( graph.csr().node_count() == 6 );
+}
+
+BOOST_AUTO_TEST_CASE( graph_concurrent_queries )
+{
+  Container::Graph graph;
+
+  for (size_t i = 0; i < 40; ++i)
+    graph.add_node(std::to_string(i));
+
+  for (size_t i = 0; i < 40; ++i) {
+    graph.add_adj(std::to_string(i), std::to_string((i + 1) % 40), 1 + i % 5);
+    graph.add_adj(std::to_string(i), std::to_string((i + 7) % 40), 9);
+  }
+
+  // const queries share no state, any number of threads may run them
+  const auto& shared = graph;
+  const auto expected = shared.radius();
+
+  std::vector<size_t> results(4);
+  std::vector<std::thread> threads;
+
+  for (size_t t = 0; t < results.size(); ++t)
+    threads.emplace_back([&shared, &result = results[t]] {
+      for (int i = 0; i < 10; ++i)
+        result = std::max(result, shared.radius());
+    });
+
+  for (auto& thread : threads)
+    thread.join();
+
+  for (const auto result : results)
+    BOOST_CHECK( result == expected );
+}
+
+BOOST_AUTO_TEST_CASE( graph_csr_weight_overflow )
+{
+  Container::Graph graph;
+  graph.add_node("a");
+  graph.add_node("b");
+
+  constexpr size_t max_weight = std::numeric_limits<std::uint32_t>::max();
+
+  graph.add_adj("a", "b", max_weight);
+  BOOST_CHECK( graph.csr().weights.front() == max_weight );
+
+  // a coast the snapshot cannot hold is reported, not truncated
+  graph.add_adj("b", "a", max_weight + 1);
+  BOOST_CHECK_THROW( graph.csr(), std::overflow_error );
+}
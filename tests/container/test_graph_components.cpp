@@ -0,0 +1,235 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "graph_components.hpp"
+#include "graph.hpp"
+
+using namespace Container;
+
+namespace {
+
+GraphCsr make_random(std::uint32_t nodes, std::uint32_t edges, unsigned seed)
+{
+  std::srand(seed);
+
+  std::vector<std::vector<std::uint32_t>> adj(nodes);
+  for (std::uint32_t i = 0; i < edges; ++i)
+    adj[std::rand() % nodes].push_back(std::rand() % nodes);
+
+  GraphCsr csr;
+  for (std::uint32_t u = 0; u < nodes; ++u) {
+    csr.labels.push_back(std::to_string(u));
+
+    for (const auto v : adj[u]) {
+      csr.targets.push_back(v);
+      csr.weights.push_back(1);
+    }
+
+    csr.offsets.push_back(csr.targets.size());
+  }
+
+  return csr;
+}
+
+std::vector<bool> reachable(const GraphCsrView& graph, std::uint32_t source)
+{
+  std::vector<bool> seen(graph.node_count(), false);
+  std::vector<std::uint32_t> stack{source};
+  seen[source] = true;
+
+  while (!stack.empty()) {
+    const auto u = stack.back();
+    stack.pop_back();
+
+    for (auto e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+      if (!seen[graph.targets[e]]) {
+        seen[graph.targets[e]] = true;
+        stack.push_back(graph.targets[e]);
+      }
+    }
+  }
+
+  return seen;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(graph_components_weak)
+{
+  Graph graph;
+
+  for (int i = 0; i < 6; ++i)
+    graph.add_node(std::to_string(i));
+
+  graph.add_adj("3", "0", 1);
+  graph.add_adj("4", "1", 1);
+  graph.add_adj("1", "5", 1);
+
+  const auto csr = graph.csr();
+  const auto result = weakly_connected_components(csr.view());
+
+  BOOST_CHECK_EQUAL(result.count, 3);
+  BOOST_CHECK(result.component == std::vector<std::uint32_t>({0, 1, 2, 0, 1, 1}));
+}
+
+BOOST_AUTO_TEST_CASE(graph_components_weak_parallel)
+{
+  // sparse enough to leave many components
+  const auto csr = make_random(20000, 9000, 35);
+  const auto expected = weakly_connected_components(csr.view(), 1);
+
+  // sequential reference on the undirected graph
+  std::vector<std::vector<std::uint32_t>> undirected(csr.node_count());
+  for (std::uint32_t u = 0; u < csr.node_count(); ++u) {
+    for (auto e = csr.offsets[u]; e < csr.offsets[u + 1]; ++e) {
+      undirected[u].push_back(csr.targets[e]);
+      undirected[csr.targets[e]].push_back(u);
+    }
+  }
+
+  std::vector<std::uint32_t> reference(csr.node_count(), csr.node_count());
+  std::uint32_t count = 0;
+
+  for (std::uint32_t root = 0; root < csr.node_count(); ++root) {
+    if (reference[root] != csr.node_count())
+      continue;
+
+    std::vector<std::uint32_t> stack{root};
+    reference[root] = count;
+
+    while (!stack.empty()) {
+      const auto u = stack.back();
+      stack.pop_back();
+
+      for (const auto v : undirected[u]) {
+        if (reference[v] == csr.node_count()) {
+          reference[v] = count;
+          stack.push_back(v);
+        }
+      }
+    }
+
+    ++count;
+  }
+
+  BOOST_CHECK_EQUAL(expected.count, count);
+  BOOST_CHECK(expected.component == reference);
+
+  for (const size_t threads : {2, 4, 8})
+    BOOST_CHECK(weakly_connected_components(csr.view(), threads).component == reference);
+}
+
+BOOST_AUTO_TEST_CASE(graph_components_strong)
+{
+  Graph graph;
+
+  for (int i = 0; i < 6; ++i)
+    graph.add_node(std::to_string(i));
+
+  graph.add_adj("0", "1", 1);
+  graph.add_adj("1", "2", 1);
+  graph.add_adj("2", "0", 1);
+  graph.add_adj("2", "3", 1);
+  graph.add_adj("3", "4", 1);
+  graph.add_adj("4", "3", 1);
+
+  const auto csr = graph.csr();
+  const auto result = strongly_connected_components(csr.view());
+
+  BOOST_CHECK_EQUAL(result.count, 3);
+  BOOST_CHECK(result.component[0] == result.component[1]);
+  BOOST_CHECK(result.component[1] == result.component[2]);
+  BOOST_CHECK(result.component[3] == result.component[4]);
+  BOOST_CHECK(result.component[0] != result.component[3]);
+  BOOST_CHECK(result.component[5] != result.component[3]);
+
+  // reverse topological order: sinks first
+  BOOST_CHECK(result.component[3] < result.component[0]);
+}
+
+BOOST_AUTO_TEST_CASE(graph_components_strong_random)
+{
+  const auto csr = make_random(300, 450, 36);
+  const auto result = strongly_connected_components(csr.view());
+
+  std::vector<std::vector<bool>> reach;
+  for (std::uint32_t u = 0; u < csr.node_count(); ++u)
+    reach.push_back(reachable(csr.view(), u));
+
+  for (std::uint32_t u = 0; u < csr.node_count(); ++u) {
+    for (std::uint32_t v = 0; v < csr.node_count(); ++v) {
+      const bool strong = reach[u][v] && reach[v][u];
+      BOOST_CHECK_EQUAL(result.component[u] == result.component[v], strong);
+
+      // an edge between components points to a smaller id
+      if (reach[u][v] && !strong)
+        BOOST_CHECK(result.component[v] < result.component[u]);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(graph_components_deep)
+{
+  // a long path would overflow a recursive implementation
+  const std::uint32_t n = 200000;
+
+  GraphCsr csr;
+  for (std::uint32_t u = 0; u < n; ++u) {
+    csr.labels.push_back(std::to_string(u));
+    csr.targets.push_back((u + 1) % n);
+    csr.weights.push_back(1);
+    csr.offsets.push_back(csr.targets.size());
+  }
+
+  BOOST_CHECK_EQUAL(strongly_connected_components(csr.view()).count, 1);
+  BOOST_CHECK(!topological_order(csr.view()));
+
+  // drop the back edge
+  csr.targets.back() = 0;
+  csr.targets.pop_back();
+  csr.weights.pop_back();
+  csr.offsets.back() = csr.targets.size();
+
+  BOOST_CHECK_EQUAL(strongly_connected_components(csr.view()).count, n);
+  BOOST_CHECK_EQUAL(weakly_connected_components(csr.view(), 4).count, 1);
+
+  const auto order = topological_order(csr.view());
+  BOOST_REQUIRE(order);
+  BOOST_CHECK_EQUAL(order->front(), 0);
+  BOOST_CHECK_EQUAL(order->back(), n - 1);
+}
+
+BOOST_AUTO_TEST_CASE(graph_components_topological_order)
+{
+  const auto csr = make_random(500, 2000, 37);
+
+  // keep forward edges only, which makes a DAG
+  GraphCsr dag;
+  for (std::uint32_t u = 0; u < csr.node_count(); ++u) {
+    dag.labels.push_back(csr.labels[u]);
+
+    for (auto e = csr.offsets[u]; e < csr.offsets[u + 1]; ++e) {
+      if (u < csr.targets[e]) {
+        dag.targets.push_back(csr.targets[e]);
+        dag.weights.push_back(1);
+      }
+    }
+
+    dag.offsets.push_back(dag.targets.size());
+  }
+
+  const auto order = topological_order(dag.view());
+  BOOST_REQUIRE(order);
+  BOOST_REQUIRE_EQUAL(order->size(), dag.node_count());
+
+  std::vector<std::uint32_t> position(dag.node_count());
+  for (std::uint32_t i = 0; i < order->size(); ++i)
+    position[(*order)[i]] = i;
+
+  for (std::uint32_t u = 0; u < dag.node_count(); ++u)
+    for (auto e = dag.offsets[u]; e < dag.offsets[u + 1]; ++e)
+      BOOST_CHECK(position[u] < position[dag.targets[e]]);
+}
@@ -0,0 +1,172 @@
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "graph_concurrent.hpp"
+
+using namespace Container;
+
+namespace {
+
+std::vector<std::pair<ConcurrentGraph::Id, std::uint32_t>> edges(const ConcurrentGraph::Snapshot& snapshot,
+                                                                   ConcurrentGraph::Id node)
+{
+  std::vector<std::pair<ConcurrentGraph::Id, std::uint32_t>> result;
+  snapshot.for_each_adj(node, [&result](auto target, auto coast) { result.push_back({target, coast}); });
+
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+size_t reachable(const ConcurrentGraph::Snapshot& snapshot, ConcurrentGraph::Id start)
+{
+  size_t result = 0;
+  snapshot.bfs_iterate(start, [&result](auto) { ++result; return false; });
+  return result;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(graph_concurrent_basic)
+{
+  ConcurrentGraph graph;
+
+  for (int i = 0; i < 4; ++i)
+    BOOST_CHECK(graph.add_node() == ConcurrentGraph::Id(i));
+
+  BOOST_CHECK(graph.add_adj(0, 1, 5));
+  BOOST_CHECK(graph.add_adj(0, 2, 6));
+  BOOST_CHECK(graph.add_adj(2, 3, 7));
+  BOOST_CHECK(!graph.add_adj(0, 9, 1));
+
+  const auto before = graph.snapshot();
+
+  BOOST_CHECK(graph.edit_adj(0, 1, 50));
+  BOOST_CHECK(graph.del_adj(0, 2));
+  BOOST_CHECK(!graph.del_adj(0, 2));
+  BOOST_CHECK(graph.del_node(3));
+  BOOST_CHECK(!graph.add_adj(1, 3, 1));
+
+  const auto after = graph.snapshot();
+
+  // the older snapshot keeps its view
+  BOOST_CHECK(edges(before, 0) == (std::vector<std::pair<ConcurrentGraph::Id, std::uint32_t>>{{1, 5}, {2, 6}}));
+  BOOST_CHECK_EQUAL(reachable(before, 0), 4);
+  BOOST_CHECK(before.contains(3));
+
+  BOOST_CHECK(edges(after, 0) == (std::vector<std::pair<ConcurrentGraph::Id, std::uint32_t>>{{1, 50}}));
+  BOOST_CHECK_EQUAL(reachable(after, 0), 2);
+  BOOST_CHECK(!after.contains(3));
+  BOOST_CHECK(edges(after, 2).empty());
+
+  // compaction keeps what open snapshots see
+  graph.compact();
+
+  BOOST_CHECK(edges(before, 0) == (std::vector<std::pair<ConcurrentGraph::Id, std::uint32_t>>{{1, 5}, {2, 6}}));
+  BOOST_CHECK(edges(after, 0) == (std::vector<std::pair<ConcurrentGraph::Id, std::uint32_t>>{{1, 50}}));
+  BOOST_CHECK_EQUAL(reachable(before, 0), 4);
+}
+
+BOOST_AUTO_TEST_CASE(graph_concurrent_compaction)
+{
+  ConcurrentGraph graph;
+
+  for (int i = 0; i < 10; ++i)
+    graph.add_node();
+
+  // many appends and deletes leave a long chain of tombstones
+  for (int round = 0; round < 100; ++round) {
+    for (ConcurrentGraph::Id v = 1; v < 10; ++v)
+      graph.add_adj(0, v, round);
+
+    if (round + 1 < 100)
+      for (ConcurrentGraph::Id v = 1; v < 10; ++v)
+        graph.del_adj(0, v);
+  }
+
+  graph.compact();
+  graph.compact();
+
+  const auto snapshot = graph.snapshot();
+  const auto result = edges(snapshot, 0);
+
+  BOOST_REQUIRE_EQUAL(result.size(), 9);
+  for (const auto& [target, coast] : result)
+    BOOST_CHECK_EQUAL(coast, 99);
+
+  BOOST_CHECK(graph.add_adj(0, 1, 7));
+  BOOST_CHECK_EQUAL(edges(graph.snapshot(), 0).size(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(graph_concurrent_writers_and_readers)
+{
+  const int writers = 4;
+  const int per_writer = 2000;
+  const ConcurrentGraph::Id nodes = writers + writers * per_writer;
+
+  ConcurrentGraph graph;
+
+  for (ConcurrentGraph::Id i = 0; i < nodes; ++i)
+    graph.add_node();
+
+  // writer w adds edges from node w to its own targets and deletes every second one
+  graph.start_compaction(std::chrono::milliseconds(1));
+
+  std::atomic<bool> done{false};
+  std::atomic<size_t> inconsistent{0};
+
+  std::thread reader([&] {
+    while (!done.load()) {
+      const auto snapshot = graph.snapshot();
+
+      // the same snapshot answers the same way twice
+      const auto first = reachable(snapshot, 0);
+      const auto second = reachable(snapshot, 0);
+
+      if (first != second)
+        ++inconsistent;
+
+      // targets are added once each, a duplicate would be a torn edit
+      for (ConcurrentGraph::Id u = 0; u < writers; ++u) {
+        auto list = edges(snapshot, u);
+        if (std::adjacent_find(list.begin(), list.end(),
+                               [](auto& a, auto& b) { return a.first == b.first; }) != list.end())
+          ++inconsistent;
+      }
+    }
+  });
+
+  std::vector<std::thread> threads;
+  for (int w = 0; w < writers; ++w) {
+    threads.emplace_back([&graph, w, nodes] {
+      for (int i = 0; i < per_writer; ++i) {
+        const auto target = static_cast<ConcurrentGraph::Id>(writers + w * per_writer + i);
+        graph.add_adj(w, target, i);
+
+        if (i % 2 == 1)
+          graph.del_adj(w, target);
+        else
+          graph.add_adj(target, (target + 1) % nodes, 1);
+      }
+    });
+  }
+
+  for (auto& thread : threads)
+    thread.join();
+
+  done.store(true);
+  reader.join();
+  graph.stop_compaction();
+
+  BOOST_CHECK_EQUAL(inconsistent.load(), 0);
+
+  const auto snapshot = graph.snapshot();
+  for (ConcurrentGraph::Id w = 0; w < writers; ++w)
+    BOOST_CHECK_EQUAL(edges(snapshot, w).size(), per_writer / 2);
+
+  graph.compact();
+  for (ConcurrentGraph::Id w = 0; w < writers; ++w)
+    BOOST_CHECK_EQUAL(edges(graph.snapshot(), w).size(), per_writer / 2);
+}
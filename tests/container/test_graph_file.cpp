@@ -0,0 +1,100 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "graph_file.hpp"
+
+using namespace Container;
+
+namespace {
+
+std::string temp_path(const std::string& name)
+{
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+Graph make_graph()
+{
+  Graph graph;
+
+  graph.add_node("alpha");
+  graph.add_node("beta");
+  graph.add_node("gamma");
+
+  graph.add_adj("alpha", "beta", 4);
+  graph.add_adj("alpha", "gamma", 9);
+  graph.add_adj("gamma", "beta", 1);
+
+  return graph;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(graph_csr_snapshot)
+{
+  const auto csr = make_graph().csr();
+
+  BOOST_CHECK(csr.node_count() == 3);
+  BOOST_CHECK(csr.edge_count() == 3);
+  BOOST_CHECK(csr.offsets == std::vector<std::uint64_t>({0, 2, 2, 3}));
+  BOOST_CHECK(csr.targets == std::vector<std::uint32_t>({1, 2, 1}));
+  BOOST_CHECK(csr.weights == std::vector<std::uint32_t>({4, 9, 1}));
+  BOOST_CHECK(csr.labels[2] == "gamma");
+}
+
+BOOST_AUTO_TEST_CASE(graph_file_round_trip)
+{
+  const auto path = temp_path("cppalgorithms_graph_file_1.bin");
+
+  BOOST_REQUIRE(write_graph_file(make_graph(), path));
+
+  const auto mapped = MappedGraph::open(path, MappedGraph::Check::Full);
+  BOOST_REQUIRE(mapped);
+
+  BOOST_CHECK(mapped->node_count() == 3);
+  BOOST_CHECK(mapped->edge_count() == 3);
+  BOOST_CHECK(mapped->label(0) == "alpha");
+  BOOST_CHECK(mapped->label(1) == "beta");
+
+  const auto g = mapped->view();
+  BOOST_CHECK(g.degree(0) == 2);
+  BOOST_CHECK(g.targets[g.offsets[2]] == 1);
+  BOOST_CHECK(g.weights[g.offsets[2]] == 1);
+
+  const auto csr = mapped->to_csr();
+  BOOST_CHECK(csr.targets == make_graph().csr().targets);
+  BOOST_CHECK(csr.labels == make_graph().csr().labels);
+
+  std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(graph_file_corruption)
+{
+  const auto path = temp_path("cppalgorithms_graph_file_2.bin");
+
+  BOOST_REQUIRE(write_graph_file(make_graph(), path));
+
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+
+    GraphFileHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    // flip a weight
+    file.seekp(header.weights_pos);
+    file.put(42);
+  }
+
+  BOOST_CHECK(MappedGraph::open(path, MappedGraph::Check::Header));
+  BOOST_CHECK(!MappedGraph::open(path, MappedGraph::Check::Full));
+
+  std::filesystem::resize_file(path, sizeof(GraphFileHeader) + 8);
+  BOOST_CHECK(!MappedGraph::open(path));
+
+  std::remove(path.c_str());
+
+  BOOST_CHECK(!MappedGraph::open(path));
+}
@@ -0,0 +1,266 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "graph_file.hpp"
+#include "graph_hierarchy.hpp"
+
+using namespace Container;
+
+namespace {
+
+std::string temp_path(const std::string& name)
+{
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// one way streets on a grid with a few highways
+GraphCsr make_roads(int side, unsigned seed)
+{
+  std::srand(seed);
+
+  GraphCsr csr;
+  const auto id = [side](int x, int y) { return static_cast<std::uint32_t>(y * side + x); };
+
+  for (int y = 0; y < side; ++y) {
+    for (int x = 0; x < side; ++x) {
+      csr.labels.push_back(std::to_string(id(x, y)));
+
+      const auto edge = [&csr](std::uint32_t to, std::uint32_t coast) {
+        if (std::rand() % 10 != 0) {
+          csr.targets.push_back(to);
+          csr.weights.push_back(coast);
+        }
+      };
+
+      if (x + 1 < side) edge(id(x + 1, y), 10 + std::rand() % 20);
+      if (x > 0) edge(id(x - 1, y), 10 + std::rand() % 20);
+      if (y + 1 < side) edge(id(x, y + 1), 10 + std::rand() % 20);
+      if (y > 0) edge(id(x, y - 1), 10 + std::rand() % 20);
+      if (x % 8 == 0 && y + 8 < side) edge(id(x, y + 8), 50);
+
+      csr.offsets.push_back(csr.targets.size());
+    }
+  }
+
+  return csr;
+}
+
+void check_route(const GraphCsr& csr, const Route& route, std::uint32_t source, std::uint32_t target)
+{
+  BOOST_REQUIRE(!route.path.empty());
+  BOOST_CHECK_EQUAL(route.path.front(), source);
+  BOOST_CHECK_EQUAL(route.path.back(), target);
+
+  std::uint64_t total = 0;
+
+  for (size_t i = 0; i + 1 < route.path.size(); ++i) {
+    const auto u = route.path[i];
+    std::uint64_t best = unreachable_distance;
+
+    for (auto e = csr.offsets[u]; e < csr.offsets[u + 1]; ++e)
+      if (csr.targets[e] == route.path[i + 1])
+        best = std::min<std::uint64_t>(best, csr.weights[e]);
+
+    BOOST_REQUIRE(best != unreachable_distance);
+    total += best;
+  }
+
+  BOOST_CHECK_EQUAL(total, route.distance);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(graph_hierarchy_small)
+{
+  Graph graph;
+
+  for (int i = 0; i < 5; ++i)
+    graph.add_node(std::to_string(i));
+
+  graph.add_adj("0", "1", 13);
+  graph.add_adj("0", "3", 7);
+  graph.add_adj("1", "2", 2);
+  graph.add_adj("3", "1", 2);
+
+  ContractionHierarchy hierarchy(graph);
+
+  BOOST_CHECK_EQUAL(hierarchy.node_count(), 5);
+
+  const auto route = hierarchy.query(0, 2);
+  BOOST_CHECK_EQUAL(route.distance, 11);
+  BOOST_CHECK(route.path == std::vector<std::uint32_t>({0, 3, 1, 2}));
+
+  BOOST_CHECK(hierarchy.query(3, 3).path == std::vector<std::uint32_t>({3}));
+  BOOST_CHECK(hierarchy.query(2, 0).distance == unreachable_distance);
+  BOOST_CHECK(hierarchy.query(0, 4).path.empty());
+}
+
+BOOST_AUTO_TEST_CASE(graph_hierarchy_roads)
+{
+  const int side = 50;
+  const auto csr = make_roads(side, 42);
+
+  ContractionHierarchy hierarchy(csr.view());
+
+  std::vector<std::uint32_t> ranks;
+  for (std::uint32_t u = 0; u < csr.node_count(); ++u)
+    ranks.push_back(hierarchy.rank(u));
+
+  std::sort(ranks.begin(), ranks.end());
+  for (std::uint32_t i = 0; i < ranks.size(); ++i)
+    BOOST_REQUIRE_EQUAL(ranks[i], i);
+
+  std::srand(43);
+  size_t settled = 0;
+
+  for (int query = 0; query < 50; ++query) {
+    const auto source = static_cast<std::uint32_t>(std::rand() % (side * side));
+    const auto target = static_cast<std::uint32_t>(std::rand() % (side * side));
+
+    const auto expected = dijkstra(csr.view(), source)[target];
+    const auto route = hierarchy.query(source, target);
+
+    BOOST_CHECK_EQUAL(route.distance, expected);
+
+    if (expected != unreachable_distance)
+      check_route(csr, route, source, target);
+
+    settled += route.settled;
+  }
+
+  // the upward searches see a small part of the graph
+  BOOST_CHECK_LT(settled / 50, csr.node_count() / 4);
+}
+
+BOOST_AUTO_TEST_CASE(graph_hierarchy_zero_weights)
+{
+  std::srand(45);
+
+  for (int round = 0; round < 20; ++round) {
+    GraphCsr csr;
+
+    for (std::uint32_t u = 0; u < 30; ++u) {
+      csr.labels.push_back(std::to_string(u));
+
+      for (int j = 0; j < 3; ++j) {
+        csr.targets.push_back(static_cast<std::uint32_t>(std::rand() % 30));
+        csr.weights.push_back(static_cast<std::uint32_t>(std::rand() % 3));
+      }
+
+      csr.offsets.push_back(csr.targets.size());
+    }
+
+    ContractionHierarchy hierarchy(csr.view());
+
+    for (std::uint32_t source = 0; source < 30; ++source) {
+      const auto expected = dijkstra(csr.view(), source);
+
+      for (std::uint32_t target = 0; target < 30; ++target)
+        BOOST_CHECK_EQUAL(hierarchy.query(source, target).distance, expected[target]);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(graph_hierarchy_save_load)
+{
+  const auto path = temp_path("cppalgorithms_graph_hierarchy_1.bin");
+
+  const auto csr = make_roads(20, 44);
+  ContractionHierarchy built(csr.view());
+
+  BOOST_REQUIRE(built.save(path));
+
+  auto loaded = ContractionHierarchy::load(path);
+  BOOST_REQUIRE(loaded);
+
+  BOOST_CHECK_EQUAL(loaded->node_count(), built.node_count());
+  BOOST_CHECK_EQUAL(loaded->shortcut_count(), built.shortcut_count());
+
+  for (std::uint32_t source = 0; source < csr.node_count(); source += 37) {
+    for (std::uint32_t target = 0; target < csr.node_count(); target += 23) {
+      const auto expected = built.query(source, target);
+      const auto route = loaded->query(source, target);
+
+      BOOST_CHECK_EQUAL(route.distance, expected.distance);
+      BOOST_CHECK(route.path == expected.path);
+    }
+  }
+
+  // flip a byte of the body
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(100);
+    file.put('\x7f');
+  }
+
+  BOOST_CHECK(!ContractionHierarchy::load(path));
+  BOOST_CHECK(!ContractionHierarchy::load(temp_path("cppalgorithms_graph_hierarchy_missing.bin")));
+
+  std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(graph_hierarchy_load_inconsistent)
+{
+  const auto path = temp_path("cppalgorithms_graph_hierarchy_2.bin");
+
+  const auto csr = make_roads(12, 45);
+  ContractionHierarchy built(csr.view());
+  BOOST_REQUIRE(built.save(path));
+
+  std::vector<std::uint8_t> saved;
+  {
+    std::ifstream in(path, std::ios::binary);
+    saved.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+
+  // header: magic, version, reserved, 3 counts, checksum of the body
+  constexpr size_t checksum_at = 40;
+  constexpr size_t body_at = 48;
+
+  const auto n = csr.node_count();
+  const auto rank_at = saved.size() - n * sizeof(std::uint32_t);
+
+  // rewrites the ranks of a and b with a valid checksum
+  const auto load_with_ranks = [&](std::uint32_t a, std::uint32_t rank_a, std::uint32_t b, std::uint32_t rank_b) {
+    auto data = saved;
+    std::memcpy(data.data() + rank_at + a * sizeof(std::uint32_t), &rank_a, sizeof(rank_a));
+    std::memcpy(data.data() + rank_at + b * sizeof(std::uint32_t), &rank_b, sizeof(rank_b));
+
+    const auto checksum = graph_file_checksum(data.data() + body_at, data.size() - body_at);
+    std::memcpy(data.data() + checksum_at, &checksum, sizeof(checksum));
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc)
+      .write(reinterpret_cast<const char*>(data.data()), data.size());
+
+    return ContractionHierarchy::load(path);
+  };
+
+  std::uint32_t lowest = 0;
+  std::uint32_t highest = 0;
+
+  for (std::uint32_t u = 0; u < n; ++u) {
+    if (built.rank(u) < built.rank(lowest)) lowest = u;
+    if (built.rank(u) > built.rank(highest)) highest = u;
+  }
+
+  // unchanged ranks still load
+  BOOST_CHECK(load_with_ranks(lowest, built.rank(lowest), highest, built.rank(highest)));
+
+  // not a permutation: a repeated rank, a rank out of range
+  BOOST_CHECK(!load_with_ranks(lowest, built.rank(highest), highest, built.rank(highest)));
+  BOOST_CHECK(!load_with_ranks(lowest, std::uint32_t(n), highest, built.rank(highest)));
+
+  // a permutation, but the arcs of both nodes now lead downwards
+  BOOST_CHECK(!load_with_ranks(lowest, built.rank(highest), highest, built.rank(lowest)));
+
+  std::remove(path.c_str());
+}
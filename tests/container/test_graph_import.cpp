@@ -0,0 +1,88 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "graph_import.hpp"
+#include "graph.hpp"
+
+using namespace Container;
+
+namespace {
+
+std::string write_temp(const std::string& name, const std::string& content)
+{
+  const auto path = (std::filesystem::temp_directory_path() / name).string();
+  std::ofstream(path, std::ios::binary) << content;
+  return path;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(graph_import_small)
+{
+  const auto path = write_temp("cppalgorithms_import_1.txt",
+    "# comment\n"
+    "b a 7\n"
+    "\n"
+    "a\tc 3\r\n"
+    "b c 1\n"
+    "c a 2");
+
+  const auto csr = import_edge_list(path, 2);
+  std::remove(path.c_str());
+
+  BOOST_REQUIRE(csr);
+  BOOST_CHECK(csr->labels == std::vector<std::string>({"b", "a", "c"}));
+  BOOST_CHECK(csr->offsets == std::vector<std::uint64_t>({0, 2, 3, 4}));
+  BOOST_CHECK(csr->targets == std::vector<std::uint32_t>({1, 2, 2, 1}));
+  BOOST_CHECK(csr->weights == std::vector<std::uint32_t>({7, 1, 3, 2}));
+}
+
+BOOST_AUTO_TEST_CASE(graph_import_malformed)
+{
+  const auto path = write_temp("cppalgorithms_import_2.txt", "a b 1\na b x\n");
+
+  BOOST_CHECK(!import_edge_list(path));
+  std::remove(path.c_str());
+
+  BOOST_CHECK(!import_edge_list(path));
+}
+
+BOOST_AUTO_TEST_CASE(graph_import_threads)
+{
+  std::string content;
+  for (int i = 0; i < 20000; ++i)
+    content += "v" + std::to_string(i % 997) + " v" + std::to_string((i * 31) % 1009) + " " + std::to_string(i) + "\n";
+
+  const auto path = write_temp("cppalgorithms_import_3.txt", content);
+
+  const auto single = import_edge_list(path, 1);
+  const auto many = import_edge_list(path, 8);
+  std::remove(path.c_str());
+
+  BOOST_REQUIRE(single && many);
+  BOOST_CHECK(single->edge_count() == 20000);
+  BOOST_CHECK(single->labels == many->labels);
+  BOOST_CHECK(single->offsets == many->offsets);
+  BOOST_CHECK(single->targets == many->targets);
+  BOOST_CHECK(single->weights == many->weights);
+}
+
+BOOST_AUTO_TEST_CASE(graph_import_to_graph)
+{
+  const auto path = write_temp("cppalgorithms_import_4.txt",
+    "0 1 13\n0 3 7\n1 2 2\n2 0 3\n2 4 3\n3 0 8\n3 1 2\n3 4 9\n4 0 7\n");
+
+  const auto csr = import_edge_list(path);
+  std::remove(path.c_str());
+
+  BOOST_REQUIRE(csr);
+
+  const auto graph = Graph::from_csr(*csr);
+
+  BOOST_CHECK(graph.radius() == 7);
+  BOOST_CHECK(graph.csr().targets == csr->targets);
+}
@@ -0,0 +1,123 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <string>
+
+#include "graph_oracle.hpp"
+
+using namespace Container;
+
+namespace {
+
+Graph make_graph()
+{
+  Graph graph;
+
+  for (int i = 0; i < 5; ++i)
+    graph.add_node(std::to_string(i));
+
+  graph.add_adj("0", "1", 13);
+  graph.add_adj("0", "3", 7);
+  graph.add_adj("1", "2", 2);
+  graph.add_adj("2", "0", 3);
+  graph.add_adj("2", "4", 3);
+  graph.add_adj("3", "0", 8);
+  graph.add_adj("3", "1", 2);
+  graph.add_adj("3", "4", 9);
+  graph.add_adj("4", "0", 7);
+
+  return graph;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(graph_oracle_distances)
+{
+  auto graph = make_graph();
+  DistanceOracle oracle(graph);
+
+  BOOST_CHECK(!oracle.distance("0", "4"));
+
+  oracle.track("0");
+
+  BOOST_CHECK(oracle.distance("0", "4") == 14u);
+  BOOST_CHECK(oracle.distance("0", "1") == 9u);
+  BOOST_CHECK(!oracle.distance("0", "x"));
+
+  oracle.track_all();
+  BOOST_CHECK(oracle.radius() == graph.radius());
+}
+
+BOOST_AUTO_TEST_CASE(graph_oracle_edits)
+{
+  auto graph = make_graph();
+  DistanceOracle oracle(graph);
+  oracle.track("0");
+
+  oracle.add_adj("0", "4", 1);
+  BOOST_CHECK(oracle.distance("0", "4") == 1u);
+
+  oracle.del_adj("0", "4");
+  BOOST_CHECK(oracle.distance("0", "4") == 14u);
+
+  oracle.edit_adj("3", "1", 20);
+  BOOST_CHECK(oracle.distance("0", "1") == 13u);
+  BOOST_CHECK(oracle.distance("0", "2") == 15u);
+
+  oracle.add_node("5");
+  BOOST_CHECK(oracle.distance("0", "5") == DistanceOracle::unreachable);
+
+  oracle.add_adj("2", "5", 1);
+  BOOST_CHECK(oracle.distance("0", "5") == 16u);
+
+  // the graph got the same edits
+  DistanceOracle fresh(graph);
+  fresh.track("0");
+
+  for (int i = 0; i < 6; ++i)
+    BOOST_CHECK(fresh.distance("0", std::to_string(i)) == oracle.distance("0", std::to_string(i)));
+}
+
+BOOST_AUTO_TEST_CASE(graph_oracle_random_edits)
+{
+  const int n = 40;
+
+  Graph graph;
+  for (int i = 0; i < n; ++i)
+    graph.add_node(std::to_string(i));
+
+  std::srand(33);
+  for (int i = 0; i < 120; ++i)
+    graph.add_adj(std::to_string(std::rand() % n), std::to_string(std::rand() % n), 1 + std::rand() % 50);
+
+  DistanceOracle oracle(graph);
+  oracle.track_all();
+
+  bool ok = true;
+
+  for (int step = 0; step < 200; ++step) {
+    const auto from = std::to_string(std::rand() % n);
+    const auto to = std::to_string(std::rand() % n);
+
+    switch (std::rand() % 3) {
+    case 0: oracle.add_adj(from, to, 1 + std::rand() % 50); break;
+    case 1: oracle.edit_adj(from, to, 1 + std::rand() % 50); break;
+    case 2: oracle.del_adj(from, to); break;
+    }
+
+    if (step % 20 != 19)
+      continue;
+
+    DistanceOracle fresh(graph);
+    fresh.track_all();
+
+    for (int s = 0; s < n; ++s)
+      for (int t = 0; t < n; ++t)
+        ok = ok && fresh.distance(std::to_string(s), std::to_string(t))
+                == oracle.distance(std::to_string(s), std::to_string(t));
+
+    ok = ok && fresh.radius() == graph.radius();
+  }
+
+  BOOST_CHECK(ok);
+}
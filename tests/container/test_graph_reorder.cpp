@@ -0,0 +1,195 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+
+#include "graph_reorder.hpp"
+#include "graph.hpp"
+
+using namespace Container;
+
+namespace {
+
+// undirected grid with randomly shuffled vertex ids
+GraphCsr make_shuffled_grid(std::uint32_t side, unsigned seed)
+{
+  std::srand(seed);
+
+  std::vector<std::uint32_t> shuffle(side * side);
+  std::iota(shuffle.begin(), shuffle.end(), 0);
+  std::random_shuffle(shuffle.begin(), shuffle.end(), [](int n) { return std::rand() % n; });
+
+  std::vector<std::vector<std::uint32_t>> adj(side * side);
+  for (std::uint32_t y = 0; y < side; ++y) {
+    for (std::uint32_t x = 0; x < side; ++x) {
+      const auto u = shuffle[y * side + x];
+
+      if (x + 1 < side) adj[u].push_back(shuffle[y * side + x + 1]);
+      if (x > 0) adj[u].push_back(shuffle[y * side + x - 1]);
+      if (y + 1 < side) adj[u].push_back(shuffle[(y + 1) * side + x]);
+      if (y > 0) adj[u].push_back(shuffle[(y - 1) * side + x]);
+    }
+  }
+
+  GraphCsr csr;
+  for (std::uint32_t u = 0; u < side * side; ++u) {
+    csr.labels.push_back(std::to_string(u));
+
+    for (const auto v : adj[u]) {
+      csr.targets.push_back(v);
+      csr.weights.push_back(u + v);
+    }
+
+    csr.offsets.push_back(csr.targets.size());
+  }
+
+  return csr;
+}
+
+bool is_permutation(std::vector<std::uint32_t> p)
+{
+  std::sort(p.begin(), p.end());
+
+  for (std::uint32_t i = 0; i < p.size(); ++i)
+    if (p[i] != i)
+      return false;
+
+  return true;
+}
+
+// largest id distance along an edge
+std::uint64_t bandwidth(const GraphCsr& csr)
+{
+  std::uint64_t result = 0;
+
+  for (std::uint32_t u = 0; u < csr.node_count(); ++u)
+    for (auto e = csr.offsets[u]; e < csr.offsets[u + 1]; ++e)
+      result = std::max<std::uint64_t>(result, u < csr.targets[e] ? csr.targets[e] - u : u - csr.targets[e]);
+
+  return result;
+}
+
+// mean id range of the neighbours of a vertex
+double span(const GraphCsr& csr)
+{
+  double result = 0;
+
+  for (std::uint32_t u = 0; u < csr.node_count(); ++u) {
+    const auto first = csr.targets.begin() + csr.offsets[u];
+    const auto last = csr.targets.begin() + csr.offsets[u + 1];
+
+    if (first != last)
+      result += *std::max_element(first, last) - *std::min_element(first, last);
+  }
+
+  return result / csr.node_count();
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(graph_reorder_relabel)
+{
+  Graph graph;
+
+  for (int i = 0; i < 4; ++i)
+    graph.add_node(std::to_string(i));
+
+  graph.add_adj("0", "3", 5);
+  graph.add_adj("0", "1", 7);
+  graph.add_adj("2", "0", 9);
+
+  const auto csr = graph.csr();
+  const auto relabeled = relabel(csr, {3, 2, 1, 0});
+
+  BOOST_CHECK(relabeled.labels == std::vector<std::string>({"3", "2", "1", "0"}));
+  BOOST_CHECK(relabeled.offsets == std::vector<std::uint64_t>({0, 0, 1, 1, 3}));
+  BOOST_CHECK(relabeled.targets == std::vector<std::uint32_t>({3, 0, 2}));
+  BOOST_CHECK(relabeled.weights == std::vector<std::uint32_t>({9, 5, 7}));
+
+  const auto back = Graph::from_csr(relabeled).csr();
+  BOOST_CHECK(back.targets == relabeled.targets);
+  BOOST_CHECK(back.labels == relabeled.labels);
+}
+
+BOOST_AUTO_TEST_CASE(graph_reorder_permutations)
+{
+  const auto csr = make_shuffled_grid(40, 38);
+  const auto view = csr.view();
+
+  const auto base_bandwidth = bandwidth(csr);
+  const auto base_span = span(csr);
+
+  for (const auto& p : {bfs_permutation(view), rcm_permutation(view),
+                        degree_permutation(view), gorder_permutation(view)}) {
+    BOOST_REQUIRE_EQUAL(p.size(), csr.node_count());
+    BOOST_REQUIRE(is_permutation(p));
+
+    // same graph under new names
+    const auto relabeled = relabel(csr, p);
+    BOOST_REQUIRE_EQUAL(relabeled.edge_count(), csr.edge_count());
+
+    for (std::uint32_t u = 0; u < csr.node_count(); ++u) {
+      BOOST_CHECK_EQUAL(relabeled.labels[p[u]], csr.labels[u]);
+      BOOST_CHECK_EQUAL(relabeled.offsets[p[u] + 1] - relabeled.offsets[p[u]],
+                        csr.offsets[u + 1] - csr.offsets[u]);
+
+      for (auto e = csr.offsets[u]; e < csr.offsets[u + 1]; ++e) {
+        const auto first = relabeled.targets.begin() + relabeled.offsets[p[u]];
+        const auto last = relabeled.targets.begin() + relabeled.offsets[p[u] + 1];
+
+        BOOST_CHECK(std::find(first, last, p[csr.targets[e]]) != last);
+      }
+    }
+  }
+
+  // a grid of side 40 has bandwidth 40 in row order
+  BOOST_CHECK_LE(bandwidth(relabel(csr, rcm_permutation(view))), 60);
+  BOOST_CHECK_LE(bandwidth(relabel(csr, bfs_permutation(view))), 80);
+  BOOST_CHECK_LT(bandwidth(relabel(csr, bfs_permutation(view))), base_bandwidth);
+  BOOST_CHECK_LT(span(relabel(csr, gorder_permutation(view))), base_span / 4);
+}
+
+BOOST_AUTO_TEST_CASE(graph_reorder_degree)
+{
+  Graph graph;
+
+  for (int i = 0; i < 5; ++i)
+    graph.add_node(std::to_string(i));
+
+  graph.add_adj("3", "0", 1);
+  graph.add_adj("3", "1", 1);
+  graph.add_adj("3", "2", 1);
+  graph.add_adj("1", "4", 1);
+
+  const auto p = degree_permutation(graph.csr().view());
+  BOOST_CHECK(p == std::vector<std::uint32_t>({2, 1, 3, 0, 4}));
+}
+
+BOOST_AUTO_TEST_CASE(graph_reorder_partition)
+{
+  const auto csr = make_shuffled_grid(60, 39);
+  const auto view = csr.view();
+
+  for (const std::uint32_t parts : {1, 2, 4, 7}) {
+    const auto result = partition(view, parts);
+    BOOST_REQUIRE_EQUAL(result.size(), csr.node_count());
+
+    std::vector<size_t> sizes(parts, 0);
+    for (const auto p : result) {
+      BOOST_REQUIRE_LT(p, parts);
+      ++sizes[p];
+    }
+
+    const auto limit = static_cast<size_t>(1.03 * csr.node_count() / parts + 1);
+    for (const auto size : sizes)
+      BOOST_CHECK_LE(size, limit);
+
+    // a random split would cut about (parts - 1) / parts of the edges
+    BOOST_CHECK_LE(cut_edges(view, result), csr.edge_count() / 10);
+
+    if (parts == 1)
+      BOOST_CHECK_EQUAL(cut_edges(view, result), 0);
+  }
+}
@@ -0,0 +1,171 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <vector>
+
+#include "graph_search.hpp"
+#include "graph.hpp"
+
+using namespace Container;
+
+namespace {
+
+// one way streets on a grid, coasts grow with the distance
+GraphCsr make_roads(int side, unsigned seed)
+{
+  std::srand(seed);
+
+  GraphCsr csr;
+  const auto id = [side](int x, int y) { return static_cast<std::uint32_t>(y * side + x); };
+
+  for (int y = 0; y < side; ++y) {
+    for (int x = 0; x < side; ++x) {
+      csr.labels.push_back(std::to_string(id(x, y)));
+
+      const auto edge = [&csr](std::uint32_t to, std::uint32_t coast) {
+        if (std::rand() % 10 != 0) {
+          csr.targets.push_back(to);
+          csr.weights.push_back(coast);
+        }
+      };
+
+      if (x + 1 < side) edge(id(x + 1, y), 10 + std::rand() % 20);
+      if (x > 0) edge(id(x - 1, y), 10 + std::rand() % 20);
+      if (y + 1 < side) edge(id(x, y + 1), 10 + std::rand() % 20);
+      if (y > 0) edge(id(x, y - 1), 10 + std::rand() % 20);
+
+      csr.offsets.push_back(csr.targets.size());
+    }
+  }
+
+  return csr;
+}
+
+// path follows edges and adds up to distance
+void check_route(const GraphCsr& csr, const Route& route, std::uint32_t source, std::uint32_t target)
+{
+  BOOST_REQUIRE(!route.path.empty());
+  BOOST_CHECK_EQUAL(route.path.front(), source);
+  BOOST_CHECK_EQUAL(route.path.back(), target);
+
+  std::uint64_t total = 0;
+
+  for (size_t i = 0; i + 1 < route.path.size(); ++i) {
+    const auto u = route.path[i];
+    std::uint64_t best = unreachable_distance;
+
+    for (auto e = csr.offsets[u]; e < csr.offsets[u + 1]; ++e)
+      if (csr.targets[e] == route.path[i + 1])
+        best = std::min<std::uint64_t>(best, csr.weights[e]);
+
+    BOOST_REQUIRE(best != unreachable_distance);
+    total += best;
+  }
+
+  BOOST_CHECK_EQUAL(total, route.distance);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(graph_search_transpose)
+{
+  Graph graph;
+
+  for (int i = 0; i < 3; ++i)
+    graph.add_node(std::to_string(i));
+
+  graph.add_adj("0", "2", 4);
+  graph.add_adj("1", "2", 5);
+  graph.add_adj("2", "0", 6);
+
+  const auto reversed = transpose(graph.csr());
+
+  BOOST_CHECK(reversed.offsets == std::vector<std::uint64_t>({0, 1, 1, 3}));
+  BOOST_CHECK(reversed.targets == std::vector<std::uint32_t>({2, 0, 1}));
+  BOOST_CHECK(reversed.weights == std::vector<std::uint32_t>({6, 4, 5}));
+  BOOST_CHECK(reversed.labels == graph.csr().labels);
+}
+
+BOOST_AUTO_TEST_CASE(graph_search_small)
+{
+  Graph graph;
+
+  for (int i = 0; i < 5; ++i)
+    graph.add_node(std::to_string(i));
+
+  graph.add_adj("0", "1", 13);
+  graph.add_adj("0", "3", 7);
+  graph.add_adj("1", "2", 2);
+  graph.add_adj("3", "1", 2);
+
+  const auto csr = graph.csr();
+  const auto reversed = transpose(csr);
+
+  RouteSearch search(csr.view(), reversed.view());
+
+  const auto route = search.bidirectional(0, 2);
+  BOOST_CHECK_EQUAL(route.distance, 11);
+  BOOST_CHECK(route.path == std::vector<std::uint32_t>({0, 3, 1, 2}));
+
+  const auto zero = [](std::uint32_t) { return std::uint64_t(0); };
+  BOOST_CHECK(search.astar(0, 2, zero).path == route.path);
+
+  BOOST_CHECK(search.bidirectional(2, 2).path == std::vector<std::uint32_t>({2}));
+  BOOST_CHECK_EQUAL(search.bidirectional(2, 2).distance, 0);
+
+  BOOST_CHECK(search.bidirectional(0, 4).path.empty());
+  BOOST_CHECK(search.bidirectional(0, 4).distance == unreachable_distance);
+  BOOST_CHECK(search.astar(0, 4, zero).path.empty());
+}
+
+BOOST_AUTO_TEST_CASE(graph_search_roads)
+{
+  const int side = 60;
+  const auto csr = make_roads(side, 40);
+  const auto reversed = transpose(csr);
+
+  RouteSearch search(csr.view(), reversed.view());
+  const Landmarks landmarks(csr.view(), reversed.view(), 8);
+
+  BOOST_CHECK_EQUAL(landmarks.landmarks().size(), 8);
+
+  size_t settled_dijkstra = 0;
+  size_t settled_bidirectional = 0;
+  size_t settled_alt = 0;
+
+  std::srand(41);
+
+  for (int query = 0; query < 40; ++query) {
+    const auto source = static_cast<std::uint32_t>(std::rand() % (side * side));
+    const auto target = static_cast<std::uint32_t>(std::rand() % (side * side));
+
+    const auto expected = dijkstra(csr.view(), source)[target];
+
+    const auto zero = [](std::uint32_t) { return std::uint64_t(0); };
+    const auto alt = [&landmarks, target](std::uint32_t u) { return landmarks.lower_bound(u, target); };
+
+    const auto plain = search.astar(source, target, zero);
+    const auto both = search.bidirectional(source, target);
+    const auto guided = search.astar(source, target, alt);
+
+    BOOST_CHECK_EQUAL(plain.distance, expected);
+    BOOST_CHECK_EQUAL(both.distance, expected);
+    BOOST_CHECK_EQUAL(guided.distance, expected);
+
+    if (expected == unreachable_distance)
+      continue;
+
+    check_route(csr, plain, source, target);
+    check_route(csr, both, source, target);
+    check_route(csr, guided, source, target);
+
+    BOOST_CHECK_LE(landmarks.lower_bound(source, target), expected);
+
+    settled_dijkstra += plain.settled;
+    settled_bidirectional += both.settled;
+    settled_alt += guided.settled;
+  }
+
+  BOOST_CHECK_LT(settled_bidirectional, settled_dijkstra);
+  BOOST_CHECK_LT(settled_alt * 2, settled_dijkstra);
+}
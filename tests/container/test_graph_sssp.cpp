@@ -0,0 +1,74 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <vector>
+
+#include "graph_sssp.hpp"
+#include "graph.hpp"
+
+using namespace Container;
+
+namespace {
+
+// grid with random coasts and a few long jumps, road network like
+GraphCsr make_grid(int side, unsigned seed)
+{
+  std::srand(seed);
+
+  GraphCsr csr;
+  const auto id = [side](int x, int y) { return static_cast<std::uint32_t>(y * side + x); };
+
+  for (int y = 0; y < side; ++y) {
+    for (int x = 0; x < side; ++x) {
+      csr.labels.push_back(std::to_string(id(x, y)));
+
+      const auto edge = [&csr](std::uint32_t to, std::uint32_t coast) {
+        csr.targets.push_back(to);
+        csr.weights.push_back(coast);
+      };
+
+      if (x + 1 < side) edge(id(x + 1, y), 1 + std::rand() % 100);
+      if (x > 0) edge(id(x - 1, y), 1 + std::rand() % 100);
+      if (y + 1 < side) edge(id(x, y + 1), 1 + std::rand() % 100);
+      if (y > 0) edge(id(x, y - 1), 1 + std::rand() % 100);
+      if (std::rand() % 50 == 0) edge(std::rand() % (side * side), 500 + std::rand() % 5000);
+
+      csr.offsets.push_back(csr.targets.size());
+    }
+  }
+
+  return csr;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(graph_sssp_dijkstra)
+{
+  Graph graph;
+
+  for (int i = 0; i < 5; ++i)
+    graph.add_node(std::to_string(i));
+
+  graph.add_adj("0", "1", 13);
+  graph.add_adj("0", "3", 7);
+  graph.add_adj("1", "2", 2);
+  graph.add_adj("3", "1", 2);
+
+  const auto csr = graph.csr();
+  const auto dist = dijkstra(csr.view(), 0);
+
+  BOOST_CHECK(dist == std::vector<std::uint64_t>({0, 9, 11, 7, unreachable_distance}));
+  BOOST_CHECK(delta_stepping(csr.view(), 0, 3, 2) == dist);
+}
+
+BOOST_AUTO_TEST_CASE(graph_sssp_delta_stepping)
+{
+  const auto csr = make_grid(60, 34);
+  const auto expected = dijkstra(csr.view(), 17);
+
+  for (const std::uint64_t delta : {1, 25, 100, 1000, 100000}) {
+    for (const size_t threads : {1, 3, 8}) {
+      BOOST_CHECK(delta_stepping(csr.view(), 17, delta, threads) == expected);
+    }
+  }
+}
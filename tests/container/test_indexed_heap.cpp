@@ -0,0 +1,73 @@
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <cstdlib>
+
+#include "indexed_heap.hpp"
+
+using namespace Container;
+
+BOOST_AUTO_TEST_CASE(container_indexed_heap_construct) // 1
+{
+  IndexedHeap<int> heap(10);
+
+  BOOST_CHECK(heap.empty());
+  BOOST_CHECK(heap.capacity() == 10);
+  BOOST_CHECK(!heap.contains(3));
+}
+
+BOOST_AUTO_TEST_CASE(container_indexed_heap_decrease_key) // 2
+{
+  IndexedHeap<int, 2> heap;
+
+  heap.push(0, 50);
+  heap.push(1, 40);
+  heap.push(2, 30);
+  heap.push(7, 20);
+
+  BOOST_CHECK(heap.top() == 7);
+  BOOST_CHECK(heap.contains(2));
+
+  heap.decrease_key(0, 10);
+  BOOST_CHECK(heap.top() == 0);
+  BOOST_CHECK(heap.top_value() == 10);
+
+  BOOST_CHECK(!heap.push_or_decrease(1, 45));
+  BOOST_CHECK(heap.push_or_decrease(1, 5));
+  BOOST_CHECK(heap.push_or_decrease(3, 25));
+
+  std::vector<size_t> order;
+  while (!heap.empty()) {
+    order.push_back(heap.top());
+    heap.pop();
+  }
+
+  BOOST_CHECK(order == std::vector<size_t>({1, 0, 7, 3, 2}));
+  BOOST_CHECK(!heap.contains(1));
+}
+
+BOOST_AUTO_TEST_CASE(container_indexed_heap_random) // 3
+{
+  const size_t n = 500;
+  IndexedHeap<int> heap(n);
+  std::vector<int> keys(n);
+
+  std::srand(5);
+  for (size_t i = 0; i < n; ++i)
+    heap.push(i, keys[i] = 1000 + std::rand() % 1000);
+
+  for (size_t i = 0; i < n; i += 3)
+    heap.decrease_key(i, keys[i] -= std::rand() % 1000);
+
+  bool ok = true;
+  int last = -1;
+
+  while (!heap.empty()) {
+    const auto id = heap.top();
+    ok = ok && heap.top_value() == keys[id] && last <= keys[id];
+    last = keys[id];
+    heap.pop();
+  }
+
+  BOOST_CHECK(ok);
+}
@@ -0,0 +1,84 @@
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+#include "pairing_heap.hpp"
+
+using namespace Container;
+
+BOOST_AUTO_TEST_CASE(container_pairing_heap_construct) // 1
+{
+  PairingHeap<int> heap;
+
+  BOOST_CHECK(heap.empty());
+  BOOST_CHECK(heap.top_handle() == PairingHeap<int>::npos);
+}
+
+BOOST_AUTO_TEST_CASE(container_pairing_heap_order) // 2
+{
+  PairingHeap<int> heap;
+  std::vector<int> values;
+
+  std::srand(30);
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(std::rand() % 500);
+    heap.push(values.back());
+  }
+
+  std::sort(values.begin(), values.end());
+
+  std::vector<int> result;
+  while (!heap.empty()) {
+    result.push_back(heap.top());
+    heap.pop();
+  }
+
+  BOOST_CHECK(result == values);
+}
+
+BOOST_AUTO_TEST_CASE(container_pairing_heap_decrease_key) // 3
+{
+  PairingHeap<int> heap;
+
+  std::vector<size_t> handles;
+  for (int i = 0; i < 100; ++i)
+    handles.push_back(heap.push(1000 + i));
+
+  heap.pop(); // 1000, restructures the tree
+
+  heap.decrease_key(handles[50], 5);
+  heap.decrease_key(handles[99], 3);
+  heap.decrease_key(handles[10], 4);
+
+  BOOST_CHECK(heap.top() == 3);
+  BOOST_CHECK(heap.top_handle() == handles[99]);
+  heap.pop();
+
+  BOOST_CHECK(heap.top() == 4);
+  heap.pop();
+
+  BOOST_CHECK(heap.top() == 5);
+  heap.pop();
+
+  // handles are reused after pop
+  const auto handle = heap.push(0);
+  BOOST_CHECK(handle < 100);
+  BOOST_CHECK(heap.value(handle) == 0);
+  heap.pop();
+
+  int last = 0;
+  bool sorted = true;
+  size_t count = 0;
+
+  while (!heap.empty()) {
+    sorted = sorted && last <= heap.top();
+    last = heap.top();
+    heap.pop();
+    ++count;
+  }
+
+  BOOST_CHECK(sorted);
+  BOOST_CHECK(count == 96);
+}
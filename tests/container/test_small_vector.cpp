@@ -0,0 +1,85 @@
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+#include "small_vector.hpp"
+
+BOOST_AUTO_TEST_CASE( small_vector_spill )
+{
+  Container::SmallVector<int, 4> v;
+
+  for (int i = 0; i < 4; ++i)
+    v.push_back(i);
+
+  BOOST_CHECK( v.is_inline() );
+  BOOST_CHECK( v.capacity() == 4 );
+
+  v.push_back(4);
+
+  BOOST_CHECK( !v.is_inline() );
+  BOOST_CHECK( v.size() == 5 );
+
+  for (int i = 0; i < 5; ++i)
+    BOOST_CHECK( v[i] == i );
+}
+
+
+BOOST_AUTO_TEST_CASE( small_vector_copy_move )
+{
+  Container::SmallVector<std::string, 2> small{"a", "b"};
+  Container::SmallVector<std::string, 2> large{"a", "b", "c", "d"};
+
+  auto small_copy = small;
+  auto large_copy = large;
+
+  BOOST_CHECK( small_copy.is_inline() && small_copy.size() == 2 && small_copy[1] == "b" );
+  BOOST_CHECK( large_copy.size() == 4 && large_copy[3] == "d" );
+
+  const auto buffer = large.data();
+  auto large_moved = std::move(large);
+
+  BOOST_CHECK( large_moved.data() == buffer );
+  BOOST_CHECK( large.empty() && large.is_inline() );
+
+  auto small_moved = std::move(small);
+
+  BOOST_CHECK( small_moved.is_inline() && small_moved[0] == "a" );
+
+  small_moved = large_copy;
+  BOOST_CHECK( small_moved.size() == 4 && small_moved[2] == "c" );
+
+  large_copy = std::move(small_copy);
+  BOOST_CHECK( large_copy.size() == 2 && large_copy[0] == "a" );
+}
+
+
+BOOST_AUTO_TEST_CASE( small_vector_erase )
+{
+  Container::SmallVector<std::string, 2> v{"0", "1", "2", "3", "4"};
+
+  v.erase(v.begin() + 1);
+  BOOST_CHECK( (std::vector<std::string>(v.begin(), v.end()) == std::vector<std::string>{"0", "2", "3", "4"}) );
+
+  v.erase_unordered(v.begin());
+  BOOST_CHECK( (std::vector<std::string>(v.begin(), v.end()) == std::vector<std::string>{"4", "2", "3"}) );
+
+  v.erase_unordered(v.end() - 1);
+  BOOST_CHECK( (std::vector<std::string>(v.begin(), v.end()) == std::vector<std::string>{"4", "2"}) );
+
+  v.clear();
+  BOOST_CHECK( v.empty() );
+}
+
+
+BOOST_AUTO_TEST_CASE( small_vector_self_reference )
+{
+  Container::SmallVector<std::string, 1> v{std::string(32, 'x')};
+
+  // growing must not invalidate the argument before it is copied
+  v.push_back(v.front());
+  v.emplace_back(v.back());
+
+  BOOST_CHECK( v.size() == 3 );
+  BOOST_CHECK( v[2] == std::string(32, 'x') );
+}
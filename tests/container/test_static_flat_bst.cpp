@@ -0,0 +1,68 @@
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <string_view>
+#include <vector>
+
+#include "static_flat_bst.hpp"
+
+using namespace Container;
+
+namespace
+{
+
+constexpr StaticFlatBst codes(std::array{503, 200, 404, 301, 500, 204, 302});
+
+static_assert(codes.size() == 7);
+static_assert(codes.contains(200) && codes.contains(404) && codes.contains(503));
+static_assert(!codes.contains(0) && !codes.contains(201) && !codes.contains(600));
+static_assert(codes.lower_bound(205) == 301);
+static_assert(codes.lower_bound(503) == 503);
+static_assert(!codes.lower_bound(504));
+
+constexpr std::array<int, 1000> make_values()
+{
+  std::array<int, 1000> values{};
+  for (size_t i = 0; i < values.size(); ++i)
+    values[i] = static_cast<int>((i * 7919) % 1000) * 3;
+  return values;
+}
+
+constexpr StaticFlatBst large(make_values());
+
+static_assert(large.contains(2997) && !large.contains(2998));
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(container_static_flat_bst_lookup)
+{
+  for (int value = -1; value < 3000; ++value) {
+    BOOST_CHECK(large.contains(value) == (value >= 0 && value % 3 == 0));
+
+    const auto bound = large.lower_bound(value);
+    if (value > 2997)
+      BOOST_CHECK(!bound);
+    else
+      BOOST_CHECK(bound && *bound == (value < 0 ? 0 : (value + 2) / 3 * 3));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(container_static_flat_bst_iterate)
+{
+  std::vector<int> values;
+  codes.lnr_iterate([&values](int value) { values.push_back(value); });
+
+  BOOST_CHECK((values == std::vector<int>{200, 204, 301, 302, 404, 500, 503}));
+}
+
+BOOST_AUTO_TEST_CASE(container_static_flat_bst_edge)
+{
+  constexpr StaticFlatBst<int, 0> none(std::array<int, 0>{});
+  static_assert(none.empty() && !none.contains(1) && !none.lower_bound(1));
+
+  constexpr StaticFlatBst words(std::array<std::string_view, 4>{"put", "get", "post", "delete"});
+  static_assert(words.contains("get") && !words.contains("head"));
+  static_assert(words.lower_bound("head") == "post");
+
+  BOOST_CHECK(words.size() == 4);
+}
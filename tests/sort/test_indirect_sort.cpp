@@ -0,0 +1,99 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "indirect_sort.hpp"
+
+namespace {
+
+size_t moves = 0;
+size_t copies = 0;
+size_t keys = 0;
+
+struct Record
+{
+  explicit Record(int _id, int _group) : id(_id), group(_group) { }
+
+  Record(const Record& other) : id(other.id), group(other.group), payload(other.payload) { ++copies; }
+  Record(Record&& other) noexcept : id(other.id), group(other.group), payload(other.payload) { ++moves; }
+
+  Record& operator= (const Record& other) { id = other.id; group = other.group; payload = other.payload; ++copies; return *this; }
+  Record& operator= (Record&& other) noexcept { id = other.id; group = other.group; payload = other.payload; ++moves; return *this; }
+
+  int key() const { ++keys; return group; }
+
+  int id;
+  int group;
+  std::array<char, 256> payload = {};
+};
+
+std::vector<Record> make_records(size_t count)
+{
+  std::vector<Record> result;
+  result.reserve(count);
+
+  std::srand(17);
+  for (size_t i = 0; i < count; ++i)
+    result.emplace_back(static_cast<int>(i), std::rand() % 100);
+
+  return result;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(argsort_stable)
+{
+  const std::vector<int> v{5, 1, 4, 1, 5, 9, 2, 6};
+
+  const auto perm = Sort::argsort<std::uint32_t>(v.begin(), v.end());
+
+  BOOST_CHECK(perm == std::vector<std::uint32_t>({1, 3, 6, 2, 0, 4, 7, 5}));
+  BOOST_CHECK(Sort::argsort(v.begin(), v.end(), std::greater<>()).front() == 5);
+}
+
+BOOST_AUTO_TEST_CASE(apply_permutation_cycles)
+{
+  std::vector<std::string> v{"c", "a", "d", "b", "e"};
+  std::vector<size_t> perm{1, 3, 0, 2, 4};
+
+  Sort::apply_permutation(v.begin(), perm);
+
+  BOOST_CHECK(v == std::vector<std::string>({"a", "b", "c", "d", "e"}));
+  BOOST_CHECK(perm == std::vector<size_t>({0, 1, 2, 3, 4}));
+}
+
+BOOST_AUTO_TEST_CASE(sort_by_key_heavy_records)
+{
+  auto records = make_records(5000);
+
+  moves = copies = keys = 0;
+
+  Sort::sort_by_key(records.begin(), records.end(), [](const Record& r) { return r.key(); });
+
+  BOOST_CHECK(keys == records.size());
+  BOOST_CHECK(copies == 0);
+
+  // once each, plus a temporary per cycle
+  BOOST_CHECK(moves <= 2 * records.size());
+
+  for (size_t i = 1; i < records.size(); ++i) {
+    BOOST_REQUIRE(records[i - 1].group <= records[i].group);
+
+    if (records[i - 1].group == records[i].group)
+      BOOST_REQUIRE(records[i - 1].id < records[i].id);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(sort_by_key_compare)
+{
+  std::vector<std::string> v{"bb", "a", "dddd", "ccc", "e"};
+
+  Sort::sort_by_key(v.begin(), v.end(), [](const std::string& s) { return s.size(); }, std::greater<>());
+
+  BOOST_CHECK(v == std::vector<std::string>({"dddd", "ccc", "bb", "a", "e"}));
+}
@@ -0,0 +1,122 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "kway_merge.hpp"
+
+namespace {
+
+using Entry = std::pair<int, int>; // key, source
+
+std::vector<std::vector<Entry>> make_runs(size_t count, size_t max_length)
+{
+  std::vector<std::vector<Entry>> runs(count);
+
+  std::srand(23);
+  for (size_t i = 0; i < count; ++i) {
+    runs[i].resize(std::rand() % (max_length + 1));
+
+    for (auto& entry : runs[i])
+      entry = {std::rand() % 1000, static_cast<int>(i)};
+
+    std::sort(runs[i].begin(), runs[i].end(),
+      [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+  }
+
+  return runs;
+}
+
+bool by_key(const Entry& lhs, const Entry& rhs) { return lhs.first < rhs.first; }
+
+std::vector<Entry> expected_merge(const std::vector<std::vector<Entry>>& runs)
+{
+  std::vector<Entry> result;
+  for (const auto& run : runs)
+    result.insert(result.end(), run.begin(), run.end());
+
+  std::stable_sort(result.begin(), result.end(), by_key);
+  return result;
+}
+
+template <class Iterator>
+std::vector<std::pair<Iterator, Iterator>> ranges_of(const std::vector<std::vector<Entry>>& runs)
+{
+  std::vector<std::pair<Iterator, Iterator>> ranges;
+  for (const auto& run : runs)
+    ranges.emplace_back(run.begin(), run.end());
+  return ranges;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(kway_merge_ranges)
+{
+  for (const size_t count : {0, 1, 2, 7, 300}) {
+    const auto runs = make_runs(count, 50);
+
+    std::vector<Entry> merged;
+    Sort::kway_merge(ranges_of<std::vector<Entry>::const_iterator>(runs), std::back_inserter(merged), by_key);
+
+    // equal keys keep the order of their sources
+    BOOST_REQUIRE(merged == expected_merge(runs));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(kway_merge_queues)
+{
+  std::vector<std::queue<int>> queues(3);
+
+  for (const auto value : {1, 4, 9})
+    queues[0].push(value);
+
+  for (const auto value : {2, 3, 10, 11})
+    queues[2].push(value);
+
+  std::vector<int> merged;
+  Sort::kway_merge(queues, std::back_inserter(merged));
+
+  BOOST_CHECK(merged == std::vector<int>({1, 2, 3, 4, 9, 10, 11}));
+  BOOST_CHECK(queues[0].empty() && queues[2].empty());
+}
+
+BOOST_AUTO_TEST_CASE(kway_merge_lazy)
+{
+  const std::vector<int> a{9, 5, 1};
+  const std::vector<int> b{8, 6, 2, 0};
+
+  using Source = Sort::RangeSource<std::vector<int>::const_iterator>;
+
+  Sort::LoserTree<Source, std::greater<>> tree({Source(a.begin(), a.end()), Source(b.begin(), b.end())});
+
+  BOOST_CHECK(tree.top() == 9 && tree.top_source() == 0);
+
+  std::vector<int> first_four;
+  for (auto it = tree.begin(); it != tree.end() && first_four.size() < 4; ++it)
+    first_four.push_back(*it);
+
+  BOOST_CHECK(first_four == std::vector<int>({9, 8, 6, 5}));
+
+  std::vector<int> rest(tree.begin(), tree.end());
+  BOOST_CHECK(rest == std::vector<int>({2, 1, 0}));
+  BOOST_CHECK(tree.empty());
+}
+
+BOOST_AUTO_TEST_CASE(kway_merge_parallel)
+{
+  for (const size_t count : {1, 5, 64}) {
+    const auto runs = make_runs(count, 40000);
+    const auto expected = expected_merge(runs);
+
+    std::vector<Entry> merged(expected.size());
+    const auto end = Sort::parallel_kway_merge(ranges_of<std::vector<Entry>::const_iterator>(runs), merged.begin(), by_key, 4);
+
+    BOOST_REQUIRE(end == merged.end());
+    BOOST_REQUIRE(merged == expected);
+  }
+}
@@ -0,0 +1,119 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "string_sort.hpp"
+
+namespace {
+
+std::vector<std::string> make_urls(size_t count)
+{
+  const std::vector<std::string> hosts = {
+    "https://example.com/", "https://example.com/api/v1/", "https://example.org/", "http://example.com/"
+  };
+
+  std::vector<std::string> result;
+  std::srand(11);
+
+  for (size_t i = 0; i < count; ++i) {
+    auto url = hosts[std::rand() % hosts.size()];
+
+    for (int part = std::rand() % 4; part >= 0; --part)
+      url += "item/" + std::to_string(std::rand() % 50) + "/";
+
+    result.push_back(url);
+  }
+
+  return result;
+}
+
+size_t common_prefix(const std::string& lhs, const std::string& rhs)
+{
+  return std::mismatch(lhs.begin(), lhs.begin() + std::min(lhs.size(), rhs.size()), rhs.begin()).first - lhs.begin();
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(string_sort_small)
+{
+  std::vector<std::string> v{"b", "", "ab", "a", "abc", "ab", "B"};
+
+  Sort::string_sort(v.begin(), v.end());
+
+  BOOST_CHECK(v == std::vector<std::string>({"", "B", "a", "ab", "ab", "abc", "b"}));
+}
+
+BOOST_AUTO_TEST_CASE(string_sort_urls)
+{
+  for (const size_t count : {100, 3000, 20000}) {
+    auto v = make_urls(count);
+    auto expected = v;
+
+    std::vector<size_t> lcp;
+    Sort::string_sort(v.begin(), v.end(), lcp);
+    std::sort(expected.begin(), expected.end());
+
+    BOOST_REQUIRE(v == expected);
+    BOOST_REQUIRE(lcp.size() == count && lcp[0] == 0);
+
+    for (size_t i = 1; i < count; ++i)
+      BOOST_REQUIRE(lcp[i] == common_prefix(v[i - 1], v[i]));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(string_sort_zero_bytes)
+{
+  using namespace std::string_literals;
+
+  std::vector<std::string> v;
+  for (int i = 0; i < 200; ++i)
+    v.push_back(std::string(i % 13, '\0') + std::string(i % 3, 'x') + std::string(i % 11, '\0'));
+
+  auto expected = v;
+
+  Sort::string_sort(v.begin(), v.end());
+  std::sort(expected.begin(), expected.end());
+
+  BOOST_CHECK(v == expected);
+}
+
+BOOST_AUTO_TEST_CASE(string_sort_arena)
+{
+  const auto urls = make_urls(5000);
+
+  std::string arena;
+  std::vector<size_t> offsets;
+
+  for (const auto& url : urls) {
+    offsets.push_back(arena.size());
+    arena += url;
+    arena += '\0';
+  }
+
+  std::vector<std::string_view> views;
+  std::vector<const char*> pointers;
+
+  for (size_t i = 0; i < urls.size(); ++i) {
+    views.emplace_back(arena.data() + offsets[i], urls[i].size());
+    pointers.push_back(arena.data() + offsets[i]);
+  }
+
+  const auto arena_copy = arena;
+
+  Sort::string_sort(views.begin(), views.end());
+  Sort::string_sort(pointers.begin(), pointers.end());
+
+  auto expected = urls;
+  std::sort(expected.begin(), expected.end());
+
+  BOOST_CHECK(arena == arena_copy);
+
+  for (size_t i = 0; i < expected.size(); ++i) {
+    BOOST_REQUIRE(views[i] == expected[i]);
+    BOOST_REQUIRE(pointers[i] == expected[i]);
+  }
+}
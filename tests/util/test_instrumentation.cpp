@@ -0,0 +1,164 @@
+#include <boost/test/unit_test.hpp>
+
+#include <queue>
+#include <string>
+#include <thread>
+
+#include "instrumentation.hpp"
+#include "clist.hpp"
+#include "flat_bst.hpp"
+#include "flat_rbst.hpp"
+#include "graph.hpp"
+#include "quick_sort.hpp"
+
+using namespace Container;
+using Utility::counters_reset;
+using Utility::counters_snapshot;
+
+static_assert(Utility::instrumentation_enabled);
+
+BOOST_AUTO_TEST_CASE(instrumentation_clist)
+{
+  counters_reset();
+
+  CList<int> list;
+  for (int i = 0; i < 10; ++i)
+    list.push_back(9 - i);
+
+  auto counters = counters_snapshot();
+  BOOST_CHECK(counters.allocations == 10);
+  BOOST_CHECK(counters.allocated_bytes == 10 * sizeof(CListNode<int>));
+  BOOST_CHECK(counters.comparisons == 0);
+
+  list.sort();
+
+  counters = counters_snapshot();
+  BOOST_CHECK(counters.allocations == 10);
+  BOOST_CHECK(counters.comparisons >= 9 && counters.comparisons <= 10 * 4);
+
+  counters_reset();
+  list[7];
+  BOOST_CHECK(counters_snapshot().steps == 7);
+}
+
+BOOST_AUTO_TEST_CASE(instrumentation_quick_sort)
+{
+  counters_reset();
+
+  std::queue<int> q;
+  for (int i = 0; i < 16; ++i)
+    q.push(i);
+
+  Sort::quick_sort(q);
+
+  const auto counters = counters_snapshot();
+
+  // sorted input makes the first element a worst case pivot
+  BOOST_CHECK(counters.max_depth == 15);
+  BOOST_CHECK(counters.comparisons >= 15 * 16 / 2);
+  BOOST_CHECK(counters.moves > 0);
+
+  // every level fills an equal and a greater queue
+  BOOST_CHECK(counters.allocations >= 15 * 2);
+  BOOST_CHECK(counters.allocated_bytes >= counters.allocations * sizeof(int));
+}
+
+BOOST_AUTO_TEST_CASE(instrumentation_flat_trees)
+{
+  counters_reset();
+
+  FlatBst<int> bst;
+  bst.insert({4, 2, 6, 1, 3, 5, 7});
+
+  auto counters = counters_snapshot();
+  BOOST_CHECK(counters.max_depth == 3);
+  BOOST_CHECK(counters.moves == 7);
+  BOOST_CHECK(counters.allocations > 0);
+
+  counters_reset();
+  BOOST_CHECK(bst.contains(7));
+
+  counters = counters_snapshot();
+  BOOST_CHECK(counters.steps == 3);
+  BOOST_CHECK(counters.comparisons == 6);
+
+  counters_reset();
+
+  FlatRbst<int> rbst;
+  rbst.insert({4, 2, 6, 1, 3, 5, 7});
+
+  counters = counters_snapshot();
+  BOOST_CHECK(counters.steps >= 7);
+  BOOST_CHECK(counters.moves >= 7);
+  BOOST_CHECK(counters.max_depth >= 1);
+
+  counters_reset();
+  rbst.lnr_iterate([](int) { });
+  BOOST_CHECK(counters_snapshot().steps == 7);
+}
+
+BOOST_AUTO_TEST_CASE(instrumentation_graph)
+{
+  counters_reset();
+
+  Graph graph;
+
+  // the node block and the first node array
+  graph.add_node("a");
+
+  auto counters = counters_snapshot();
+  BOOST_CHECK(counters.allocations == 2);
+  BOOST_CHECK(counters.allocated_bytes > sizeof(GraphNode) + sizeof(GraphNodePtr));
+
+  const auto node_bytes = counters.allocated_bytes - sizeof(GraphNodePtr);
+
+  counters_reset();
+  graph.add_adj("a", "a", 1);
+
+  // one list node, links included
+  counters = counters_snapshot();
+  BOOST_CHECK(counters.allocations == 1);
+  BOOST_CHECK(counters.allocated_bytes > sizeof(GraphAdjacency));
+
+  const auto adjacency_bytes = counters.allocated_bytes;
+
+  for (const auto label : {"b", "c", "d"})
+    graph.add_node(label);
+
+  graph.add_adj("a", "b", 1);
+  graph.add_adj("b", "c", 1);
+
+  counters_reset();
+  graph.bfs_iterate(0, [](const auto&) { return false; });
+
+  // d is not reachable from a
+  BOOST_CHECK(counters_snapshot().steps == 3);
+
+  // the same nodes and edges cost the same when built from a snapshot,
+  // the node array is allocated once at its final size
+  const auto csr = graph.csr();
+
+  counters_reset();
+  Graph::from_csr(csr);
+
+  counters = counters_snapshot();
+  BOOST_CHECK(counters.allocations == 4 + 3 + 1);
+  BOOST_CHECK(counters.allocated_bytes
+              == 4 * node_bytes + 3 * adjacency_bytes + 4 * sizeof(GraphNodePtr));
+}
+
+BOOST_AUTO_TEST_CASE(instrumentation_total)
+{
+  const auto before = Utility::counters_total();
+
+  std::thread worker([] {
+    CList<int> list;
+    list.push_back(1);
+    list.push_back(2);
+  });
+  worker.join();
+
+  // the exited thread is still counted
+  const auto after = Utility::counters_total();
+  BOOST_CHECK(after.allocations - before.allocations == 2);
+}
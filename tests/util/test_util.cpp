@@ -1,10 +1,18 @@
 #include <boost/test/unit_test.hpp>
 
 #include <vector>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 
 #include "range_offset.hpp"
+#include "range_adaptors.hpp"
+#include "parallel.hpp"
+#include "clist.hpp"
+#include "flat_btree.hpp"
 
 BOOST_AUTO_TEST_CASE(range_offset_1)
 {
@@ -19,3 +27,313 @@ BOOST_AUTO_TEST_CASE(range_offset_1)
 
   BOOST_CHECK(target == oss.str());
 }
+
+BOOST_AUTO_TEST_CASE(range_adaptors_take_stride)
+{
+  std::ostringstream oss;
+  std::vector<int> v = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+  for (auto i : v | Utility::stride(2) | Utility::take(3)) {
+    oss << i << " ";
+  }
+
+  for (auto i : v | Utility::take(100) | Utility::stride(4)) {
+    oss << i << " ";
+  }
+
+  const std::string target = "1 3 5 1 5 9 ";
+
+  BOOST_CHECK(target == oss.str());
+}
+
+BOOST_AUTO_TEST_CASE(range_adaptors_filter_transform)
+{
+  std::ostringstream oss;
+  std::vector<int> v = {1, 2, 3, 4, 5, 6};
+
+  const auto even = [](int i) { return i % 2 == 0; };
+  const auto square = [](int i) { return i * i; };
+
+  for (auto i : v | Utility::filter(even) | Utility::transform(square)) {
+    oss << i << " ";
+  }
+
+  const std::string target = "4 16 36 ";
+
+  BOOST_CHECK(target == oss.str());
+}
+
+BOOST_AUTO_TEST_CASE(range_adaptors_chunk)
+{
+  std::ostringstream oss;
+  std::vector<int> v = {1, 2, 3, 4, 5, 6, 7};
+
+  for (auto c : v | Utility::chunk(3)) {
+    for (auto i : c)
+      oss << i;
+    oss << " ";
+  }
+
+  const std::string target = "123 456 7 ";
+
+  BOOST_CHECK(target == oss.str());
+}
+
+BOOST_AUTO_TEST_CASE(range_adaptors_zip_enumerate)
+{
+  std::ostringstream oss;
+  std::vector<int> v = {1, 2, 3};
+  std::vector<char> c = {'a', 'b', 'c', 'd'};
+
+  for (auto [i, ch] : v | Utility::zip(c)) {
+    oss << i << ch << " ";
+  }
+
+  for (auto [index, i] : v | Utility::enumerate()) {
+    i *= 10;
+    oss << index << ":" << i << " ";
+  }
+
+  const std::string target = "1a 2b 3c 0:10 1:20 2:30 ";
+
+  BOOST_CHECK(target == oss.str());
+  BOOST_CHECK(v == std::vector<int>({10, 20, 30}));
+}
+
+BOOST_AUTO_TEST_CASE(range_adaptors_containers)
+{
+  std::ostringstream oss;
+
+  Container::CList<int> clist;
+  for (int i = 1; i <= 6; ++i)
+    clist.push_back(i);
+
+  const auto odd = [](int i) { return i % 2 == 1; };
+
+  for (auto i : clist | Utility::filter(odd) | Utility::take(2)) {
+    oss << i << " ";
+  }
+
+  const Container::FlatBtree<int> tree{7, 3, 5, 1};
+
+  for (auto [index, i] : tree | Utility::stride(2) | Utility::enumerate()) {
+    oss << index << ":" << i << " ";
+  }
+
+  const std::string target = "1 3 0:1 1:5 ";
+
+  BOOST_CHECK(target == oss.str());
+}
+
+BOOST_AUTO_TEST_CASE(range_adaptors_constexpr)
+{
+  constexpr auto sum = [] {
+    int v[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    int s = 0;
+    for (auto i : v | Utility::stride(3) | Utility::transform([](int i) { return i * 2; }))
+      s += i;
+    return s;
+  }();
+
+  static_assert(sum == (1 + 4 + 7) * 2);
+  BOOST_CHECK(sum == 24);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_each)
+{
+  Utility::ThreadPool pool(4);
+
+  std::vector<int> v(10000);
+  std::iota(v.begin(), v.end(), 0);
+
+  Utility::for_each(v, [](int& i) { i *= 2; }, pool);
+
+  bool ok = true;
+  for (int i = 0; i < 10000; ++i)
+    ok = ok && v[i] == i * 2;
+
+  BOOST_CHECK(ok);
+
+  Container::CList<int> clist;
+  for (int i = 1; i <= 1000; ++i)
+    clist.push_back(i);
+
+  std::atomic<int> sum{0};
+  Utility::for_each(clist, [&sum](int i) { sum += i; }, pool);
+
+  BOOST_CHECK(sum == 500500);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_split_cache_lines)
+{
+  std::vector<int> v(10000);
+
+  // every chunk after the first starts on a cache line, whatever the offset
+  for (std::size_t skip = 0; skip < 20; ++skip) {
+    const auto chunks = Utility::Detail::split(v | Utility::offset(skip), 4);
+
+    bool aligned = true;
+    std::size_t covered = 0;
+
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+      const auto address = reinterpret_cast<std::uintptr_t>(&*chunks[i].first);
+
+      aligned = aligned && (i == 0 || address % Utility::Detail::cache_line == 0);
+      aligned = aligned && chunks[i].index == covered;
+      covered += chunks[i].size;
+    }
+
+    BOOST_CHECK(aligned);
+    BOOST_CHECK(covered == v.size() - skip);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(parallel_transform_reduce)
+{
+  Utility::ThreadPool pool(4);
+
+  std::vector<long> v(100000);
+  std::iota(v.begin(), v.end(), 1);
+
+  const auto plus = [](long lhs, long rhs) { return lhs + rhs; };
+  const auto square = [](long i) { return i * i % 7; };
+
+  const auto expected = std::transform_reduce(v.begin(), v.end(), 5L, plus, square);
+
+  BOOST_CHECK(Utility::transform_reduce(v, 5L, plus, square, pool) == expected);
+  BOOST_CHECK(Utility::transform_reduce(v | Utility::offset(10), 0L, plus, square, pool)
+              == std::transform_reduce(v.begin() + 10, v.end(), 0L, plus, square));
+  BOOST_CHECK(Utility::transform_reduce(std::vector<long>{}, 3L, plus, square, pool) == 3L);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_inclusive_scan)
+{
+  Utility::ThreadPool pool(3);
+
+  std::vector<int> v(5000);
+  std::iota(v.begin(), v.end(), -100);
+
+  std::vector<int> expected(v.size());
+  std::inclusive_scan(v.begin(), v.end(), expected.begin());
+
+  std::vector<int> result(v.size());
+  const auto end = Utility::inclusive_scan(v, result.begin(), std::plus<>{}, pool);
+
+  BOOST_CHECK(end == result.end());
+  BOOST_CHECK(result == expected);
+
+  Container::CList<int> clist;
+  for (int i = 1; i <= 100; ++i)
+    clist.push_back(i);
+
+  std::vector<int> scanned(100);
+  Utility::inclusive_scan(clist, scanned.begin(), std::plus<>{}, pool);
+
+  BOOST_CHECK(scanned.back() == 5050);
+  BOOST_CHECK(scanned[9] == 55);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_exceptions)
+{
+  Utility::ThreadPool pool(4);
+
+  std::vector<int> v(10000);
+  std::iota(v.begin(), v.end(), 0);
+
+  const auto throw_at = [](int i) {
+    if (i == 7777)
+      throw std::runtime_error("task");
+    return i;
+  };
+
+  BOOST_CHECK_THROW(Utility::for_each(v, throw_at, pool), std::runtime_error);
+  BOOST_CHECK_THROW(Utility::transform_reduce(v, 0, std::plus<>{}, throw_at, pool),
+                    std::runtime_error);
+
+  std::vector<int> result(v.size());
+  const auto throwing_plus = [](int lhs, int rhs) {
+    if (rhs == 7777)
+      throw std::runtime_error("task");
+    return lhs + rhs;
+  };
+
+  BOOST_CHECK_THROW(Utility::inclusive_scan(v, result.begin(), throwing_plus, pool),
+                    std::runtime_error);
+
+  // a group is usable again once wait() has thrown
+  Utility::TaskGroup group(pool);
+  std::atomic<int> count{0};
+
+  group.run([] { throw std::logic_error("first"); });
+  group.run([&count] { ++count; });
+  BOOST_CHECK_THROW(group.wait(), std::logic_error);
+
+  group.run([&count] { ++count; });
+  group.wait();
+
+  BOOST_CHECK(count == 2);
+  BOOST_CHECK(Utility::transform_reduce(v, 0L, std::plus<>{}, [](int i) { return long(i); }, pool)
+              == 49995000L);
+}
+
+BOOST_AUTO_TEST_CASE(range_offset_clamped)
+{
+  std::ostringstream oss;
+  std::vector<int> v = {1, 2, 3};
+
+  for (auto i : v | Utility::offset(10)) {
+    oss << i << " ";
+  }
+
+  Container::CList<int> clist;
+  clist.push_back(1);
+  clist.push_back(2);
+
+  for (auto i : clist | Utility::offset(1)) {
+    oss << i << " ";
+  }
+
+  for (auto i : clist | Utility::offset(5)) {
+    oss << i << " ";
+  }
+
+  const std::string target = "2 ";
+
+  BOOST_CHECK(target == oss.str());
+}
+
+BOOST_AUTO_TEST_CASE(range_offset_owning)
+{
+  std::ostringstream oss;
+
+  const auto make = [] { return std::vector<int>{1, 2, 3, 4, 5, 6}; };
+
+  for (auto i : make() | Utility::offset(2) | Utility::stride(2)) {
+    oss << i << " ";
+  }
+
+  const auto view = make() | Utility::filter([](int i) { return i > 4; });
+
+  for (auto i : view) {
+    oss << i << " ";
+  }
+
+  const std::string target = "3 5 5 6 ";
+
+  BOOST_CHECK(target == oss.str());
+}
+
+BOOST_AUTO_TEST_CASE(range_offset_constexpr)
+{
+  constexpr auto sum = [] {
+    int v[] = {1, 2, 3, 4};
+    int s = 0;
+    for (auto i : v | Utility::offset(2))
+      s += i;
+    return s;
+  }();
+
+  static_assert(sum == 7);
+  static_assert(Utility::offset(3).offset == 3);
+  BOOST_CHECK(sum == 7);
+}